@@ -0,0 +1,246 @@
+// @file ai.c
+// @brief Depth-first max search over one player turn with a transposition table.
+//
+// The only random event in a fight is the next draw, which lies past the end of the turn, so the
+// turn itself is deterministic. The search enumerates every play (card, target, end turn), ends the
+// turn exactly like Game_Update does, runs the enemy response through the combat rules and scores the
+// result. The score stands in for the chance nodes beyond the horizon.
+
+#include "ai.h"
+#include "platform.h"
+#include "zobrist.h"
+#include <stdlib.h>
+#include <string.h>
+
+// --- Evaluation weights ---
+#define AI_WIN_SCORE 100000.0f
+#define AI_LOSS_SCORE -100000.0f
+#define AI_W_PLAYER_HEALTH 1.0f
+#define AI_W_PLAYER_SHIELD 0.5f
+#define AI_W_ENEMY_HEALTH 0.7f  // Per point of enemy health + shield left
+#define AI_W_ENEMY_ATTACK 1.5f  // Per point of attack the survivors hit back with next turn
+#define AI_W_ENEMY_ALIVE 3.0f
+
+#define AI_TIME_CHECK_INTERVAL 1024 // Nodes between wall clock checks
+
+// One position inside the turn. Small and self-contained so children are plain copies.
+typedef struct {
+    Player player;
+    Encounter encounter;
+    RunCard hand[RUN_MAX_HAND];
+    int hand_size;
+    int played_cards;
+    uint64_t hash;      // Zobrist hash of player and enemies, carried over from the combat rules
+    uint64_t hand_hash; // Sum of the card keys in hand
+} AiNode;
+
+typedef struct {
+    uint64_t key;
+    float value;
+    uint32_t generation; // Entry is empty unless it matches the current search
+} AiTableEntry;
+
+struct AiSearch {
+    AiTableEntry* table;
+    uint64_t table_mask;
+    uint32_t generation;
+
+    AiBudget budget;
+    double deadline;
+    long long nodes;
+    long long tt_hits;
+    bool aborted;
+};
+
+AiSearch* Ai_Create(int tt_bits) {
+    if (tt_bits < 4) tt_bits = 4;
+    if (tt_bits > 26) tt_bits = 26;
+    AiSearch* search = calloc(1, sizeof(AiSearch));
+    if (!search) return NULL;
+    search->table = calloc((size_t)1 << tt_bits, sizeof(AiTableEntry));
+    if (!search->table) { free(search); return NULL; }
+    search->table_mask = ((uint64_t)1 << tt_bits) - 1;
+    return search;
+}
+
+void Ai_Destroy(AiSearch* search) {
+    if (!search) return;
+    free(search->table);
+    free(search);
+}
+
+// --- Hashing ---
+
+// Transposition key: the incrementally maintained combat and hand hashes plus the play count.
+static uint64_t NodeKey(const AiNode* node) {
+    return node->hash ^ node->hand_hash ^ Zobrist_Key(ZOBRIST_PLAYED_CARDS, 0, node->played_cards);
+}
+
+static bool ProbeTable(AiSearch* search, uint64_t key, float* value) {
+    const AiTableEntry* entry = &search->table[key & search->table_mask];
+    if (entry->generation != search->generation || entry->key != key) return false;
+    *value = entry->value;
+    return true;
+}
+
+static void StoreTable(AiSearch* search, uint64_t key, float value) {
+    AiTableEntry* entry = &search->table[key & search->table_mask];
+    entry->key = key;
+    entry->value = value;
+    entry->generation = search->generation;
+}
+
+// --- Rules ---
+
+static float Evaluate(const AiNode* node) {
+    const Player* p = &node->player;
+    if (p->health <= 0) return AI_LOSS_SCORE;
+
+    float score = AI_W_PLAYER_HEALTH * (float)p->health + AI_W_PLAYER_SHIELD * (float)p->shield;
+    const Encounter* enc = &node->encounter;
+    int living = 0;
+    for (int i = 0; i < enc->enemy_count; i++) {
+        if (!enc->alive[i]) continue;
+        living++;
+        score -= AI_W_ENEMY_HEALTH * (float)(enc->health[i] + enc->shield[i]);
+        score -= AI_W_ENEMY_ATTACK * (float)enc->attack[i];
+        score -= AI_W_ENEMY_ALIVE;
+    }
+    // A cleared level is worth more than anything short of it; more health left breaks ties
+    if (living == 0) return AI_WIN_SCORE + (float)p->health;
+    return score;
+}
+
+// Ends the turn at this position: the enemies answer, then the result is scored.
+static float EndTurnValue(const AiNode* node) {
+    AiNode after = *node;
+    CombatState combat;
+    Combat_Bind(&combat, &after.player, &after.encounter, after.hash);
+    Combat_RunEnemyTurn(&combat);
+    return Evaluate(&after);
+}
+
+// Plays hand[index] at target into child. Returns false if the card has no valid target.
+static bool PlayCard(const AiNode* node, int index, int target, AiNode* child) {
+    *child = *node;
+    CombatState combat;
+    Combat_Bind(&combat, &child->player, &child->encounter, node->hash);
+    const RunCard* card = &node->hand[index];
+    if (!Combat_ApplyCard(&combat, card->type, card->effect, card->power, target)) return false;
+    child->hash = combat.hash;
+    child->hand_hash -= Zobrist_CardKey(card->type, card->effect, card->power);
+
+    memmove(&child->hand[index], &child->hand[index + 1], sizeof(RunCard) * (size_t)(child->hand_size - index - 1));
+    child->hand_size--;
+    child->played_cards++;
+    return true;
+}
+
+static bool AllEnemiesDead(const AiNode* node) {
+    for (int i = 0; i < node->encounter.enemy_count; i++) {
+        if (node->encounter.alive[i]) return false;
+    }
+    return true;
+}
+
+// Returns true if an identical card sits earlier in the hand, so this one needn't be tried.
+static bool IsDuplicateCard(const AiNode* node, int index) {
+    const RunCard* card = &node->hand[index];
+    for (int i = 0; i < index; i++) {
+        const RunCard* other = &node->hand[i];
+        if (other->type == card->type && other->effect == card->effect && other->power == card->power) return true;
+    }
+    return false;
+}
+
+static bool BudgetExceeded(AiSearch* search) {
+    if (search->aborted) return true;
+    if (search->budget.max_nodes > 0 && search->nodes >= search->budget.max_nodes) search->aborted = true;
+    else if (search->budget.max_seconds > 0.0 && search->nodes % AI_TIME_CHECK_INTERVAL == 0
+        && Platform_Seconds() >= search->deadline) search->aborted = true;
+    return search->aborted;
+}
+
+// Returns the value of the best line from this position. At the root, best_index/best_target
+// receive the first play of that line.
+static float Search(AiSearch* search, const AiNode* node, int* best_index, int* best_target) {
+    search->nodes++;
+
+    uint64_t key = NodeKey(node);
+    float value;
+    if (!best_index && ProbeTable(search, key, &value)) {
+        search->tt_hits++;
+        return value;
+    }
+
+    // Ending the turn is always allowed
+    float best = EndTurnValue(node);
+    if (best_index) { *best_index = -1; *best_target = -1; }
+
+    for (int i = 0; i < node->hand_size && !BudgetExceeded(search); i++) {
+        if (IsDuplicateCard(node, i)) continue;
+        const RunCard* card = &node->hand[i];
+
+        // Single-target attacks branch on every living enemy. CLEAVE, heals and shields don't depend on
+        // the target, so they're tried once (CLEAVE still needs a living enemy to aim at).
+        bool branch_targets = card->type == Attack && card->effect != CLEAVE;
+        for (int t = 0; t < node->encounter.enemy_count; t++) {
+            if (!node->encounter.alive[t]) continue;
+
+            AiNode child;
+            int target = (card->type == Attack) ? t : -1;
+            if (!PlayCard(node, i, target, &child)) continue;
+
+            float child_value;
+            if (AllEnemiesDead(&child)) child_value = Evaluate(&child);
+            else if (child.hand_size < 3 && child.played_cards == RUN_CARDS_PER_TURN_CAP) child_value = EndTurnValue(&child);
+            else if (child.hand_size == 0) child_value = EndTurnValue(&child);
+            else child_value = Search(search, &child, NULL, NULL);
+
+            if (child_value > best) {
+                best = child_value;
+                if (best_index) { *best_index = i; *best_target = target; }
+            }
+            if (!branch_targets) break;
+        }
+    }
+
+    // Only fully searched subtrees are exact enough to reuse
+    if (!search->aborted) StoreTable(search, key, best);
+    return best;
+}
+
+AiMove Ai_FindBestMove(AiSearch* search, const Player* player, const Encounter* encounter,
+    const RunCard* hand, int hand_size, int played_cards, AiBudget budget) {
+    AiMove move = { -1, -1, 0.0f, 0, 0, true };
+    if (!search || !player || !encounter || !hand) return move;
+    if (hand_size > RUN_MAX_HAND) hand_size = RUN_MAX_HAND;
+
+    AiNode root;
+    memset(&root, 0, sizeof(root));
+    root.player = *player;
+    root.encounter = *encounter;
+    memcpy(root.hand, hand, sizeof(RunCard) * (size_t)hand_size);
+    root.hand_size = hand_size;
+    root.played_cards = played_cards;
+    root.hash = Zobrist_HashCombat(&root.player, &root.encounter);
+    for (int i = 0; i < hand_size; i++) root.hand_hash += Zobrist_CardKey(hand[i].type, hand[i].effect, hand[i].power);
+
+    // A new generation empties the table without touching it
+    search->generation++;
+    if (search->generation == 0) {
+        memset(search->table, 0, sizeof(AiTableEntry) * (size_t)(search->table_mask + 1));
+        search->generation = 1;
+    }
+    search->budget = budget;
+    search->deadline = budget.max_seconds > 0.0 ? Platform_Seconds() + budget.max_seconds : 0.0;
+    search->nodes = 0;
+    search->tt_hits = 0;
+    search->aborted = false;
+
+    move.value = Search(search, &root, &move.hand_index, &move.target);
+    move.nodes = search->nodes;
+    move.tt_hits = search->tt_hits;
+    move.complete = !search->aborted;
+    return move;
+}
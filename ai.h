@@ -0,0 +1,39 @@
+// Lookahead solver for the player turn: searches every order, target and CLEAVE choice for the
+// cards in hand, answers each line with the enemy turn from the headless rules and picks the best.
+// Used by the "search" simulator policy and the in-game hint key. Never touches CProcessing.
+#pragma once
+#include <stdbool.h>
+#include <stdint.h>
+#include "run.h"
+
+#define AI_TT_BITS_DEFAULT 16 // 65536 transposition table entries
+
+// Limits for one search. A zero field means no limit on that axis.
+typedef struct {
+    long long max_nodes; // Positions expanded before giving up (deterministic)
+    double max_seconds;  // Wall time before giving up (not deterministic; use for the hint only)
+} AiBudget;
+
+// Result of a search.
+typedef struct {
+    int hand_index;     // Card to play next, or -1 to end the turn
+    int target;         // Enemy index for attacks, -1 for heal/shield cards
+    float value;        // Score of the best line found (higher is better for the player)
+    long long nodes;    // Positions expanded
+    long long tt_hits;  // Positions answered by the transposition table
+    bool complete;      // False if the budget ran out before the whole turn was searched
+} AiMove;
+
+typedef struct AiSearch AiSearch;
+
+// Creates a solver with a transposition table of 2^tt_bits entries. Returns NULL on failure.
+AiSearch* Ai_Create(int tt_bits);
+
+// Frees a solver created with Ai_Create.
+void Ai_Destroy(AiSearch* search);
+
+// Finds the best next play for the hand. played_cards counts cards already played this turn, for
+// the auto-end rule. Each search is independent, so the same input and node budget always give
+// the same move.
+AiMove Ai_FindBestMove(AiSearch* search, const Player* player, const Encounter* encounter,
+    const RunCard* hand, int hand_size, int played_cards, AiBudget budget);
@@ -0,0 +1,110 @@
+// @file aoe.c
+// @brief Branch-free shield-then-health AOE mitigation, 8 or 4 enemies per step.
+//
+// Per living enemy:  blocked = min(damage, shield);  dealt = damage - blocked;
+//                    shield -= blocked;  health -= dealt;  alive = health > 0
+// Dead lanes are masked to zero damage so they come out unchanged.
+
+#include "aoe.h"
+
+#if defined(__AVX2__)
+#define AOE_AVX2 1
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define AOE_SSE2 1
+#include <emmintrin.h>
+#endif
+
+// One enemy, same math as the vector lanes.
+static int32_t AoeScalar(int32_t* health, int32_t* shield, int32_t* alive, int i, int32_t damage,
+    int32_t* blocked_out, int32_t* dealt_out) {
+    int32_t live = -(int32_t)(alive[i] != 0);    // All ones if alive
+    int32_t hit = damage & live;
+    int32_t blocked = shield[i] < hit ? shield[i] : hit;
+    int32_t dealt = hit - blocked;
+    shield[i] -= blocked;
+    health[i] -= dealt;
+    alive[i] = (int32_t)(health[i] > 0) & (live & 1);
+    blocked_out[i] = blocked;
+    dealt_out[i] = dealt;
+    return dealt;
+}
+
+int ApplyAoeDamage(int32_t* health, int32_t* shield, int32_t* alive, int count, int damage,
+    int32_t* blocked_out, int32_t* dealt_out) {
+    if (!health || !shield || !alive || !blocked_out || !dealt_out || damage <= 0) return 0;
+    int total = 0;
+    int i = 0;
+
+#if defined(AOE_AVX2)
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i one = _mm256_set1_epi32(1);
+    const __m256i dmg = _mm256_set1_epi32(damage);
+    __m256i sum = zero;
+    for (; i + 8 <= count; i += 8) {
+        __m256i h = _mm256_loadu_si256((const __m256i*)(health + i));
+        __m256i s = _mm256_loadu_si256((const __m256i*)(shield + i));
+        __m256i a = _mm256_loadu_si256((const __m256i*)(alive + i));
+        __m256i live = _mm256_cmpgt_epi32(a, zero);
+        __m256i hit = _mm256_and_si256(dmg, live);
+        __m256i blocked = _mm256_min_epi32(s, hit);
+        __m256i dealt = _mm256_sub_epi32(hit, blocked);
+        s = _mm256_sub_epi32(s, blocked);
+        h = _mm256_sub_epi32(h, dealt);
+        a = _mm256_and_si256(_mm256_and_si256(_mm256_cmpgt_epi32(h, zero), live), one);
+        _mm256_storeu_si256((__m256i*)(health + i), h);
+        _mm256_storeu_si256((__m256i*)(shield + i), s);
+        _mm256_storeu_si256((__m256i*)(alive + i), a);
+        _mm256_storeu_si256((__m256i*)(blocked_out + i), blocked);
+        _mm256_storeu_si256((__m256i*)(dealt_out + i), dealt);
+        sum = _mm256_add_epi32(sum, dealt);
+    }
+    int32_t lanes[8];
+    _mm256_storeu_si256((__m256i*)lanes, sum);
+    for (int l = 0; l < 8; l++) total += lanes[l];
+#elif defined(AOE_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i one = _mm_set1_epi32(1);
+    const __m128i dmg = _mm_set1_epi32(damage);
+    __m128i sum = zero;
+    for (; i + 4 <= count; i += 4) {
+        __m128i h = _mm_loadu_si128((const __m128i*)(health + i));
+        __m128i s = _mm_loadu_si128((const __m128i*)(shield + i));
+        __m128i a = _mm_loadu_si128((const __m128i*)(alive + i));
+        __m128i live = _mm_cmpgt_epi32(a, zero);
+        __m128i hit = _mm_and_si128(dmg, live);
+        // SSE2 has no 32-bit min: pick hit where shield > hit, shield elsewhere
+        __m128i shield_bigger = _mm_cmpgt_epi32(s, hit);
+        __m128i blocked = _mm_or_si128(_mm_and_si128(shield_bigger, hit), _mm_andnot_si128(shield_bigger, s));
+        __m128i dealt = _mm_sub_epi32(hit, blocked);
+        s = _mm_sub_epi32(s, blocked);
+        h = _mm_sub_epi32(h, dealt);
+        a = _mm_and_si128(_mm_and_si128(_mm_cmpgt_epi32(h, zero), live), one);
+        _mm_storeu_si128((__m128i*)(health + i), h);
+        _mm_storeu_si128((__m128i*)(shield + i), s);
+        _mm_storeu_si128((__m128i*)(alive + i), a);
+        _mm_storeu_si128((__m128i*)(blocked_out + i), blocked);
+        _mm_storeu_si128((__m128i*)(dealt_out + i), dealt);
+        sum = _mm_add_epi32(sum, dealt);
+    }
+    int32_t lanes[4];
+    _mm_storeu_si128((__m128i*)lanes, sum);
+    for (int l = 0; l < 4; l++) total += lanes[l];
+#endif
+
+    // Remainder (or everything, without SIMD)
+    for (; i < count; i++) {
+        total += AoeScalar(health, shield, alive, i, damage, blocked_out, dealt_out);
+    }
+    return total;
+}
+
+const char* ApplyAoeDamage_Path(void) {
+#if defined(AOE_AVX2)
+    return "avx2";
+#elif defined(AOE_SSE2)
+    return "sse2";
+#else
+    return "scalar";
+#endif
+}
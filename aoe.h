@@ -0,0 +1,15 @@
+// Vectorized area-of-effect damage over structure-of-arrays enemy stats (see Encounter in levels.h).
+// Shared by CLEAVE, Divine Strike and Shield Bash. AVX2 or SSE2 when the compiler targets them,
+// plain C otherwise; every path gives identical results.
+#pragma once
+#include <stdint.h>
+
+// Hits every living enemy in [0, count) for damage: the shield absorbs first, the rest comes off
+// health, and enemies left at 0 health or less die. Dead enemies are untouched.
+// blocked_out/dealt_out (count entries each) receive each enemy's absorbed and health damage.
+// Returns the total health damage dealt. damage <= 0 does nothing.
+int ApplyAoeDamage(int32_t* health, int32_t* shield, int32_t* alive, int count, int damage,
+    int32_t* blocked_out, int32_t* dealt_out);
+
+// Name of the code path ApplyAoeDamage was built with ("avx2", "sse2" or "scalar").
+const char* ApplyAoeDamage_Path(void);
@@ -0,0 +1,184 @@
+// @file assets.c
+// @brief Handle registry, reference counts and the intro-time preloader.
+//
+// CProcessing's loaders take a path and need the render context, so decoding has to stay on the
+// main thread. The preload thread does the part that can move: it maps each queued file and touches
+// every page, so the disk wait is over by the time Asset_Pump hands the path to CP_*_Load.
+
+#include "assets.h"
+#include "platform.h"
+#include "trace.h"
+#include <stdio.h>
+#include <string.h>
+
+#define ASSET_PATH_SIZE 128
+#define ASSET_PAGE_SIZE 4096
+
+typedef struct {
+    AssetKind kind;
+    char path[ASSET_PATH_SIZE];
+    int refs;
+    bool loaded;             // Load attempted (the asset may still be NULL if the file is missing)
+    CP_Image image;          // Set for ASSET_IMAGE
+    CP_Sound sound;          // Set for ASSET_SOUND and ASSET_MUSIC
+    CP_Font font;            // Set for ASSET_FONT
+    PlatformAtomic64 read;   // Set by the preload thread once the file has been read
+} AssetEntry;
+
+static AssetEntry entries[ASSET_MAX];
+static int entry_count = 0;
+
+// Preload queue: indices into entries[], fixed once the thread starts
+static int preload_queue[ASSET_MAX];
+static int preload_count = 0;
+static int preload_next = 0; // First queued entry Asset_Pump hasn't loaded yet
+static PlatformThread* preload_thread = NULL;
+static volatile uint8_t page_sink; // Keeps the page touches from being optimized away
+
+static AssetEntry* Lookup(AssetId id) {
+    return (id != ASSET_NONE && id <= entry_count) ? &entries[id - 1] : NULL;
+}
+
+// Returns the entry for path, registering it (unloaded, no references) if it's new.
+static AssetId Find(AssetKind kind, const char* path) {
+    for (int i = 0; i < entry_count; i++) {
+        if (entries[i].kind == kind && strcmp(entries[i].path, path) == 0) return (AssetId)(i + 1);
+    }
+    if (entry_count == ASSET_MAX || strlen(path) >= ASSET_PATH_SIZE) {
+        printf("Warning: asset registry can't take %s\n", path);
+        return ASSET_NONE;
+    }
+    AssetEntry* entry = &entries[entry_count];
+    memset(entry, 0, sizeof(*entry));
+    entry->kind = kind;
+    snprintf(entry->path, sizeof(entry->path), "%s", path);
+    return (AssetId)++entry_count;
+}
+
+static void Load(AssetEntry* entry) {
+    if (entry->loaded) return;
+    entry->loaded = true;
+    Trace_Begin(TRACE_CAT_ASSET, entry->path);
+    switch (entry->kind) {
+    case ASSET_IMAGE: entry->image = CP_Image_Load(entry->path); break;
+    case ASSET_SOUND: entry->sound = CP_Sound_Load(entry->path); break;
+    case ASSET_MUSIC: entry->sound = CP_Sound_LoadMusic(entry->path); break;
+    case ASSET_FONT:  entry->font = CP_Font_Load(entry->path); break;
+    }
+    Trace_End(TRACE_CAT_ASSET, entry->path);
+    if (!entry->image && !entry->sound && !entry->font) printf("Warning: %s not found\n", entry->path);
+}
+
+static void Unload(AssetEntry* entry) {
+    if (!entry->loaded) return;
+    if (entry->image) CP_Image_Free(entry->image);
+    if (entry->sound) CP_Sound_Free(entry->sound);
+    if (entry->font) CP_Font_Free(entry->font);
+    entry->image = NULL;
+    entry->sound = NULL;
+    entry->font = NULL;
+    entry->loaded = false;
+}
+
+AssetId Asset_Acquire(AssetKind kind, const char* path) {
+    if (!path) return ASSET_NONE;
+    AssetId id = Find(kind, path);
+    AssetEntry* entry = Lookup(id);
+    if (!entry) return ASSET_NONE;
+    Load(entry);
+    entry->refs++;
+    return id;
+}
+
+void Asset_Release(AssetId* id) {
+    if (!id) return;
+    AssetEntry* entry = Lookup(*id);
+    *id = ASSET_NONE;
+    if (!entry || entry->refs == 0) return;
+    if (--entry->refs == 0) Unload(entry);
+}
+
+CP_Image Asset_Image(AssetId id) {
+    AssetEntry* entry = Lookup(id);
+    return (entry && entry->kind == ASSET_IMAGE) ? entry->image : NULL;
+}
+
+CP_Sound Asset_Sound(AssetId id) {
+    AssetEntry* entry = Lookup(id);
+    return (entry && (entry->kind == ASSET_SOUND || entry->kind == ASSET_MUSIC)) ? entry->sound : NULL;
+}
+
+CP_Font Asset_Font(AssetId id) {
+    AssetEntry* entry = Lookup(id);
+    return (entry && entry->kind == ASSET_FONT) ? entry->font : NULL;
+}
+
+// --- Preloading ---
+
+void Asset_Preload(AssetKind kind, const char* path) {
+    if (!path || preload_thread) return;
+    AssetId id = Find(kind, path);
+    AssetEntry* entry = Lookup(id);
+    if (!entry) return;
+    for (int i = 0; i < preload_count; i++) {
+        if (preload_queue[i] == id - 1) return;
+    }
+    entry->refs++; // The registry's own reference
+    preload_queue[preload_count++] = id - 1;
+}
+
+static void PreloadThread(void* arg) {
+    (void)arg;
+    Trace_SetThreadName("Asset preload");
+    for (int i = 0; i < preload_count; i++) {
+        AssetEntry* entry = &entries[preload_queue[i]];
+        Trace_Begin(TRACE_CAT_ASSET, entry->path);
+        PlatformMappedFile file;
+        if (Platform_MapFile(entry->path, &file)) {
+            const uint8_t* bytes = (const uint8_t*)file.data;
+            uint8_t sum = 0;
+            for (size_t offset = 0; offset < file.size; offset += ASSET_PAGE_SIZE) sum ^= bytes[offset];
+            page_sink = sum;
+            Platform_UnmapFile(&file);
+        }
+        Trace_End(TRACE_CAT_ASSET, entry->path);
+        Platform_AtomicStore64(&entry->read, 1); // Missing files count as read; Load reports them
+    }
+}
+
+void Asset_StartPreload(void) {
+    if (preload_thread || preload_next == preload_count) return;
+    preload_thread = Platform_ThreadStart(PreloadThread, NULL); // Without a thread Asset_Pump reads from disk itself
+}
+
+bool Asset_Pump(double budget) {
+    double deadline = Platform_Seconds() + budget;
+    bool first = true;
+    while (preload_next < preload_count) {
+        AssetEntry* entry = &entries[preload_queue[preload_next]];
+        if (!entry->loaded) {
+            bool read = !preload_thread || Platform_AtomicLoad64(&entry->read) != 0;
+            if (!read || (!first && Platform_Seconds() >= deadline)) return false;
+            Load(entry);
+            first = false;
+        }
+        preload_next++;
+    }
+    if (preload_thread) {
+        Platform_ThreadJoin(preload_thread);
+        preload_thread = NULL;
+    }
+    return true;
+}
+
+void Asset_Shutdown(void) {
+    if (preload_thread) {
+        Platform_ThreadJoin(preload_thread);
+        preload_thread = NULL;
+    }
+    for (int i = 0; i < entry_count; i++) Unload(&entries[i]);
+    memset(entries, 0, sizeof(entries));
+    entry_count = 0;
+    preload_count = 0;
+    preload_next = 0;
+}
@@ -0,0 +1,47 @@
+// Asset registry: every image, sound and font the game loads, deduplicated by path and reference
+// counted, behind small integer handles. Files listed with Asset_Preload are read from disk on a
+// background thread during the intro and turned into CProcessing assets a few per frame, so the
+// screens that acquire them later find them already loaded.
+#pragma once
+#include "cprocessing.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#define ASSET_MAX 64
+#define ASSET_NONE ((AssetId)0)
+#define ASSET_PUMP_BUDGET 0.004 // Seconds of loading Asset_Pump may spend in one frame
+
+typedef uint16_t AssetId;
+
+typedef enum {
+    ASSET_IMAGE,
+    ASSET_SOUND,
+    ASSET_MUSIC, // Streamed sound (CP_Sound_LoadMusic)
+    ASSET_FONT,
+} AssetKind;
+
+// Returns the handle for path, loading it if no one holds it yet, and adds a reference.
+// The handle stays valid (with a NULL asset) if the file fails to load. ASSET_NONE if the registry is full.
+AssetId Asset_Acquire(AssetKind kind, const char* path);
+
+// Drops the reference *id holds and sets it to ASSET_NONE. The asset is freed with its last reference.
+void Asset_Release(AssetId* id);
+
+// Return the loaded asset behind a handle, NULL if it isn't of that kind or failed to load.
+CP_Image Asset_Image(AssetId id);
+CP_Sound Asset_Sound(AssetId id);
+CP_Font Asset_Font(AssetId id);
+
+// Queues path for loading ahead of use. The registry keeps a reference of its own, so a preloaded
+// asset stays resident until Asset_Shutdown. Call before Asset_StartPreload.
+void Asset_Preload(AssetKind kind, const char* path);
+
+// Starts the background thread that reads the queued files into the OS file cache.
+void Asset_StartPreload(void);
+
+// Loads queued assets whose files have been read, until budget seconds have passed (at least one
+// per call). Call once per frame. Returns true once everything queued is loaded.
+bool Asset_Pump(double budget);
+
+// Stops the preload thread and frees every asset, referenced or not. Call once on shutdown.
+void Asset_Shutdown(void);
@@ -0,0 +1,375 @@
+// @file bench.c
+// @brief Microbenchmarks for the card and deck primitives, with JSON output for comparing changes.
+//
+// Standalone executable. card.c lays cards out through CP_* calls, so it links the CProcessing
+// library on Windows and the headless stand-in elsewhere:
+//   gcc -O2 -std=c11 -Iheadless -pthread -o bench bench.c card.c deck.c carddef.c shuffle.c rng.c
+//       progression.c sprite.c assets.c trace.c platform.c utils.c headless/cprocessing_headless.c -lm
+//
+// Every case runs its operation in batches. A batch is grown until it takes --min-sample seconds, so
+// clock resolution stays out of the numbers; then the case warms up for --warmup seconds and takes
+// --samples timed batches. Samples outside Tukey's fences (1.5 interquartile ranges past the quartiles)
+// are dropped as interference before the statistics are computed.
+//
+// Usage: bench [--samples N] [--warmup SECONDS] [--min-sample SECONDS] [--seed S]
+//              [--filter TEXT]       (only cases whose name contains TEXT)
+//              [--catalogue FILE]    (LoadCatalogue input; a generated file is used if it can't be read)
+//                                    (LoadCatalogue/4096 always reads a generated 4096-card file)
+//              [--json FILE|-]       (machine-readable results; - for stdout instead of the table)
+
+#include "card.h"
+#include "deck.h"
+#include "platform.h"
+#include "progression.h"
+#include "rng.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BENCH_MAX_SAMPLES 1000
+#define BENCH_MAX_BATCH (1 << 24)
+#define BENCH_OUTLIER_IQR 1.5
+#define BENCH_HAND_SIZE 7
+#define BENCH_SMALL_CATALOGUE 40
+#define BENCH_LARGE_CATALOGUE 4096
+#define BENCH_GENERATED_CATALOGUE "bench_catalogue.tmp"
+#define BENCH_LARGE_CATALOGUE_PATH "bench_catalogue_large.tmp"
+
+// Shared state the cases work on. Reset before each case.
+typedef struct {
+    Rng rng;
+    Deck deck;
+    Card hand[BENCH_HAND_SIZE];
+    int hand_size;
+    Card discard[MAX_DECK_SIZE];
+    int discard_size;
+    CardCatalogue catalogue;
+    const char* catalogue_path;
+    const char* large_catalogue_path;
+    uint64_t seed;
+} BenchContext;
+
+// One benchmark. run performs iterations operations (ops_per_iteration primitive calls each).
+typedef struct {
+    const char* name;
+    const char* detail;        // What one operation includes
+    int ops_per_iteration;
+    void (*setup)(BenchContext* ctx, int deck_size);
+    void (*run)(BenchContext* ctx, long long iterations);
+    int deck_size;
+} BenchCase;
+
+// Summary of one case, in nanoseconds per operation.
+typedef struct {
+    const BenchCase* bench;
+    long long batch;           // Iterations per sample
+    int samples;
+    int rejected;              // Outliers dropped
+    double min_ns, median_ns, mean_ns, p90_ns, p99_ns, max_ns, stddev_ns;
+    double ops_per_second;
+} BenchResult;
+
+static volatile uint32_t bench_sink; // Keeps results observable so loops aren't optimized away
+
+// --- Setup ---
+
+// Fills the draw pile with deck_size cards: the starting deck, trimmed or topped up with basic attacks.
+static void SetupDeck(BenchContext* ctx, int deck_size) {
+    Rng_Init(&ctx->rng, ctx->seed, RNG_STREAM_SHUFFLE);
+    InitDeck(&ctx->deck);
+    while (ctx->deck.size > deck_size) RemoveCardFromDeck(&ctx->deck, ctx->deck.size - 1);
+    CardId extra = CardDef_Find(Attack, None, BASIC_ATTACK_POWER);
+    while (ctx->deck.size < deck_size && AddCardToDeck(&ctx->deck, extra)) {}
+    ctx->hand_size = 0;
+    ctx->discard_size = 0;
+}
+
+// Deals a full hand and lays it out, so the cards have targets to move to.
+static void SetupHand(BenchContext* ctx, int deck_size) {
+    SetupDeck(ctx, deck_size);
+    while (ctx->hand_size < BENCH_HAND_SIZE) DealFromDeck(&ctx->deck, &ctx->hand[ctx->hand_size], &ctx->hand_size, NULL);
+    SetHandPos(ctx->hand, ctx->hand_size);
+}
+
+// --- Cases ---
+
+static void RunShuffle(BenchContext* ctx, long long iterations) {
+    for (long long i = 0; i < iterations; i++) ShuffleDeck(&ctx->deck, &ctx->rng);
+    bench_sink += ctx->deck.order[ctx->deck.head];
+}
+
+static void RunDeal(BenchContext* ctx, long long iterations) {
+    for (long long i = 0; i < iterations; i++) {
+        if (ctx->hand_size == BENCH_HAND_SIZE || IsDeckEmpty(&ctx->deck)) {
+            for (int h = 0; h < ctx->hand_size; h++) ReturnCardToDeck(&ctx->deck, &ctx->hand[h]);
+            ctx->hand_size = 0;
+        }
+        DealFromDeck(&ctx->deck, &ctx->hand[ctx->hand_size], &ctx->hand_size, NULL);
+    }
+    bench_sink += ctx->hand[0].id;
+}
+
+static void RunRecycle(BenchContext* ctx, long long iterations) {
+    for (long long i = 0; i < iterations; i++) {
+        // Empty the draw pile into the discard pile, then shuffle it all back
+        while (!IsDeckEmpty(&ctx->deck)) DealFromDeck(&ctx->deck, &ctx->discard[ctx->discard_size], &ctx->discard_size, NULL);
+        RecycleDeck(ctx->discard, &ctx->deck, &ctx->discard_size, &ctx->rng);
+    }
+    bench_sink += ctx->deck.order[ctx->deck.head];
+}
+
+static void RunAddRemove(BenchContext* ctx, long long iterations) {
+    CardId id = CardDef_Find(Heal, None, BASIC_HEAL_POWER);
+    for (long long i = 0; i < iterations; i++) {
+        AddCardToDeck(&ctx->deck, id);
+        RemoveCardFromDeck(&ctx->deck, (int)(i % ctx->deck.size)); // Walks the removal point over the pile
+    }
+    bench_sink += (uint32_t)ctx->deck.size;
+}
+
+static void RunCardScale(BenchContext* ctx, long long iterations) {
+    float sum = 0.0f;
+    for (long long i = 0; i < iterations; i++) {
+        for (int size = 1; size <= BENCH_HAND_SIZE; size++) sum += CalculateCardScale(size);
+    }
+    (void)ctx;
+    bench_sink += (uint32_t)sum;
+}
+
+static void RunHandPos(BenchContext* ctx, long long iterations) {
+    for (long long i = 0; i < iterations; i++) SetHandPos(ctx->hand, ctx->hand_size);
+    bench_sink += (uint32_t)ctx->hand[ctx->hand_size - 1].target_pos.x;
+}
+
+static void RunAnimate(BenchContext* ctx, long long iterations) {
+    const float dt = 1.0f / 60.0f;
+    for (long long i = 0; i < iterations; i++) {
+        for (int h = 0; h < ctx->hand_size; h++) {
+            Card* card = &ctx->hand[h];
+            if (!card->is_animating) { // Arrived: send it back across the screen
+                card->target_pos = CP_Vector_Set(card->target_pos.x < 640.0f ? 1100.0f : 100.0f, card->target_pos.y);
+                card->is_animating = true;
+            }
+            AnimateMoveCard(card, 1500.0f, dt);
+        }
+    }
+    bench_sink += (uint32_t)ctx->hand[0].pos.x;
+}
+
+static void RunCatalogue(BenchContext* ctx, long long iterations) {
+    int loaded = 0;
+    for (long long i = 0; i < iterations; i++) loaded += LoadCatalogue(ctx->catalogue_path, &ctx->catalogue);
+    bench_sink += (uint32_t)loaded;
+}
+
+static void RunLargeCatalogue(BenchContext* ctx, long long iterations) {
+    int loaded = 0;
+    for (long long i = 0; i < iterations; i++) loaded += LoadCatalogue(ctx->large_catalogue_path, &ctx->catalogue);
+    bench_sink += (uint32_t)loaded;
+}
+
+static void SetupNothing(BenchContext* ctx, int deck_size) {
+    (void)ctx;
+    (void)deck_size;
+}
+
+static const BenchCase bench_cases[] = {
+    { "ShuffleDeck/14", "one shuffle of a 14-card draw pile", 1, SetupDeck, RunShuffle, 14 },
+    { "ShuffleDeck/25", "one shuffle of a full 25-card draw pile", 1, SetupDeck, RunShuffle, MAX_DECK_SIZE },
+    { "DealFromDeck", "one card dealt; every 7th also returns the hand to the pile", 1, SetupDeck, RunDeal, 14 },
+    { "RecycleDeck", "14 cards dealt to the discard pile, then recycled and shuffled", 1, SetupDeck, RunRecycle, 14 },
+    { "AddCardToDeck+RemoveCardFromDeck", "one card added, one removed", 1, SetupDeck, RunAddRemove, 14 },
+    { "CalculateCardScale", "one call, hand sizes 1 to 7 in turn", BENCH_HAND_SIZE, SetupNothing, RunCardScale, 0 },
+    { "SetHandPos", "layout of a 7-card hand", 1, SetupHand, RunHandPos, 14 },
+    { "AnimateMoveCard", "one card moved one logic tick", BENCH_HAND_SIZE, SetupHand, RunAnimate, 14 },
+    { "LoadCatalogue", "one catalogue file read and registered", 1, SetupNothing, RunCatalogue, 0 },
+    { "LoadCatalogue/4096", "one 4096-card catalogue file read and registered", 1, SetupNothing, RunLargeCatalogue, 0 },
+};
+
+#define BENCH_CASE_COUNT ((int)(sizeof(bench_cases) / sizeof(bench_cases[0])))
+
+// --- Measurement ---
+
+static double TimeBatch(const BenchCase* bench, BenchContext* ctx, long long iterations) {
+    double start = Platform_Seconds();
+    bench->run(ctx, iterations);
+    return Platform_Seconds() - start;
+}
+
+static int CompareDoubles(const void* a, const void* b) {
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+// Linear interpolation between the closest ranks of a sorted array.
+static double Percentile(const double* sorted, int count, double fraction) {
+    if (count == 1) return sorted[0];
+    double rank = fraction * (double)(count - 1);
+    int low = (int)rank;
+    if (low >= count - 1) return sorted[count - 1];
+    return sorted[low] + (sorted[low + 1] - sorted[low]) * (rank - (double)low);
+}
+
+static BenchResult Measure(const BenchCase* bench, BenchContext* ctx, int samples, double warmup, double min_sample) {
+    BenchResult result;
+    memset(&result, 0, sizeof(result));
+    result.bench = bench;
+    bench->setup(ctx, bench->deck_size);
+
+    // Grow the batch until one takes min_sample seconds
+    long long batch = 1;
+    while (batch < BENCH_MAX_BATCH && TimeBatch(bench, ctx, batch) < min_sample) batch *= 2;
+    result.batch = batch;
+
+    double warm_until = Platform_Seconds() + warmup;
+    while (Platform_Seconds() < warm_until) TimeBatch(bench, ctx, batch);
+
+    static double ns[BENCH_MAX_SAMPLES];
+    double ops = (double)batch * bench->ops_per_iteration;
+    for (int i = 0; i < samples; i++) ns[i] = TimeBatch(bench, ctx, batch) * 1e9 / ops;
+    qsort(ns, (size_t)samples, sizeof(double), CompareDoubles);
+
+    // Tukey's fences: keep [Q1 - k*IQR, Q3 + k*IQR]
+    double q1 = Percentile(ns, samples, 0.25), q3 = Percentile(ns, samples, 0.75);
+    double low = q1 - BENCH_OUTLIER_IQR * (q3 - q1), high = q3 + BENCH_OUTLIER_IQR * (q3 - q1);
+    int first = 0, end = samples;
+    while (first < end && ns[first] < low) first++;
+    while (end > first && ns[end - 1] > high) end--;
+    const double* kept = ns + first;
+    int count = end - first;
+    result.samples = count;
+    result.rejected = samples - count;
+
+    double sum = 0.0, squares = 0.0;
+    for (int i = 0; i < count; i++) sum += kept[i];
+    result.mean_ns = sum / count;
+    for (int i = 0; i < count; i++) squares += (kept[i] - result.mean_ns) * (kept[i] - result.mean_ns);
+    result.stddev_ns = count > 1 ? sqrt(squares / (count - 1)) : 0.0;
+    result.min_ns = kept[0];
+    result.max_ns = kept[count - 1];
+    result.median_ns = Percentile(kept, count, 0.5);
+    result.p90_ns = Percentile(kept, count, 0.9);
+    result.p99_ns = Percentile(kept, count, 0.99);
+    result.ops_per_second = result.mean_ns > 0.0 ? 1e9 / result.mean_ns : 0.0;
+    return result;
+}
+
+// --- Catalogue input ---
+
+// Writes a catalogue of distinct cards in the game's format. Returns false on failure.
+static bool WriteCatalogue(const char* path, int lines) {
+    static const char* const types[] = { "Attack", "Heal", "Shield" };
+    static const char* const effects[] = { "None", "Draw", "SHIELD_BASH", "CLEAVE" };
+    FILE* file = fopen(path, "w");
+    if (!file) return false;
+    for (int i = 0; i < lines; i++) {
+        fprintf(file, "%s,%s,%d,Deal {value} to a target. Generated catalogue line %d for the benchmark.\n",
+            types[i % 3], effects[(i / 3) % 4], 4 + i / 12, i);
+    }
+    return fclose(file) == 0;
+}
+
+// --- Output ---
+
+static void PrintTable(const BenchResult* results, int count) {
+    printf("%-34s %10s %10s %10s %10s %10s %7s %14s\n", "case", "min ns", "median", "mean", "p99", "stddev", "outl.", "ops/s");
+    for (int i = 0; i < count; i++) {
+        const BenchResult* r = &results[i];
+        printf("%-34s %10.1f %10.1f %10.1f %10.1f %10.1f %3d/%-3d %14.0f\n", r->bench->name,
+            r->min_ns, r->median_ns, r->mean_ns, r->p99_ns, r->stddev_ns, r->rejected, r->samples + r->rejected, r->ops_per_second);
+    }
+}
+
+static void WriteJson(FILE* file, const BenchResult* results, int count, int samples, double warmup, double min_sample, uint64_t seed) {
+    fprintf(file, "{\n  \"samples\": %d,\n  \"warmup_seconds\": %g,\n  \"min_sample_seconds\": %g,\n  \"seed\": %llu,\n",
+        samples, warmup, min_sample, (unsigned long long)seed);
+    fprintf(file, "  \"outlier_rule\": \"tukey %.1f IQR\",\n  \"unit\": \"ns/op\",\n  \"cases\": [", BENCH_OUTLIER_IQR);
+    for (int i = 0; i < count; i++) {
+        const BenchResult* r = &results[i];
+        fprintf(file, "%s\n    {\"name\": \"%s\", \"op\": \"%s\", \"batch\": %lld, \"ops_per_batch\": %lld, "
+            "\"samples\": %d, \"rejected\": %d, \"min\": %.3f, \"median\": %.3f, \"mean\": %.3f, \"p90\": %.3f, "
+            "\"p99\": %.3f, \"max\": %.3f, \"stddev\": %.3f, \"ops_per_second\": %.1f}",
+            i ? "," : "", r->bench->name, r->bench->detail, r->batch, r->batch * r->bench->ops_per_iteration,
+            r->samples, r->rejected, r->min_ns, r->median_ns, r->mean_ns, r->p90_ns, r->p99_ns, r->max_ns,
+            r->stddev_ns, r->ops_per_second);
+    }
+    fprintf(file, "\n  ]\n}\n");
+}
+
+static void PrintUsage(void) {
+    printf("Usage: bench [--samples N] [--warmup SECONDS] [--min-sample SECONDS] [--seed S]\n"
+           "             [--filter TEXT] [--catalogue FILE] [--json FILE|-]\n");
+}
+
+int main(int argc, char** argv) {
+    int samples = 101;
+    double warmup = 0.1;
+    double min_sample = 0.0005;
+    uint64_t seed = 1;
+    const char* filter = NULL;
+    const char* catalogue_path = "Assets/cath.txt";
+    const char* json_path = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--samples") == 0 && i + 1 < argc) samples = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--warmup") == 0 && i + 1 < argc) warmup = atof(argv[++i]);
+        else if (strcmp(argv[i], "--min-sample") == 0 && i + 1 < argc) min_sample = atof(argv[++i]);
+        else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) seed = strtoull(argv[++i], NULL, 10);
+        else if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc) filter = argv[++i];
+        else if (strcmp(argv[i], "--catalogue") == 0 && i + 1 < argc) catalogue_path = argv[++i];
+        else if (strcmp(argv[i], "--json") == 0 && i + 1 < argc) json_path = argv[++i];
+        else { PrintUsage(); return 1; }
+    }
+    if (samples < 4 || samples > BENCH_MAX_SAMPLES) {
+        printf("--samples must be between 4 and %d\n", BENCH_MAX_SAMPLES);
+        return 1;
+    }
+
+    // Same window as the game, since the hand layout depends on its width
+    CP_System_SetWindowSize(1280, 720);
+
+    BenchContext ctx;
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.seed = seed;
+    ctx.catalogue_path = catalogue_path;
+    bool generated = false;
+    FILE* probe = fopen(catalogue_path, "r");
+    if (probe) fclose(probe);
+    else if (WriteCatalogue(BENCH_GENERATED_CATALOGUE, BENCH_SMALL_CATALOGUE)) {
+        ctx.catalogue_path = BENCH_GENERATED_CATALOGUE;
+        generated = true;
+    }
+    ctx.large_catalogue_path = BENCH_LARGE_CATALOGUE_PATH;
+    if (!WriteCatalogue(BENCH_LARGE_CATALOGUE_PATH, BENCH_LARGE_CATALOGUE)) printf("Failed to write %s\n", BENCH_LARGE_CATALOGUE_PATH);
+
+    bool to_stdout = json_path && strcmp(json_path, "-") == 0;
+    FILE* log = to_stdout ? stderr : stdout;
+    fprintf(log, "catalogue: %s%s  samples: %d  warmup: %gs  min sample: %gs\n",
+        ctx.catalogue_path, generated ? " (generated)" : "", samples, warmup, min_sample);
+
+    BenchResult results[BENCH_CASE_COUNT];
+    int count = 0;
+    for (int i = 0; i < BENCH_CASE_COUNT; i++) {
+        if (filter && !strstr(bench_cases[i].name, filter)) continue;
+        results[count++] = Measure(&bench_cases[i], &ctx, samples, warmup, min_sample);
+    }
+    if (generated) remove(BENCH_GENERATED_CATALOGUE);
+    remove(BENCH_LARGE_CATALOGUE_PATH);
+    FreeCatalogue(&ctx.catalogue);
+
+    if (!to_stdout) PrintTable(results, count);
+    if (json_path) {
+        FILE* file = to_stdout ? stdout : fopen(json_path, "w");
+        if (!file) {
+            printf("Failed to write %s\n", json_path);
+            return 1;
+        }
+        WriteJson(file, results, count, samples, warmup, min_sample, seed);
+        if (!to_stdout && fclose(file) != 0) {
+            printf("Failed to write %s\n", json_path);
+            return 1;
+        }
+    }
+    return 0;
+}
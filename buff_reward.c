@@ -4,6 +4,7 @@
 #include "buff_reward.h"
 #include "game.h"       // Include game.h to get the full Player struct definition
 #include "utils.h"      // For IsAreaClicked
+#include "assets.h"
 #include <stdio.h>      // For snprintf
 
 // --- Static variables for this state ---
@@ -19,47 +20,48 @@ static void ApplyBuffReward(BuffRewardState* state, Player* player) {
     if (!player || state->selected_index < 0 || state->selected_index >= state->num_options) {
         return;
     }
+    Progression_ApplyBuff(player, state->options[state->selected_index].type);
+}
 
-    BuffType selected_buff = state->options[state->selected_index].type;
-
-    // --- Calculate scaling buff amount ---
-    int boss_count = 0;
-    if (player->max_health > 50) boss_count++; // Simple check if Lvl 3 buff was taken
-    if (player->max_health > 70) boss_count++; // Simple check if Lvl 6 buff was taken
-
-    // int hp_gain = 20 + (10 * boss_count); // <-- No longer used
-    int attack_gain = 2 + (1 * boss_count);
-
-
-    switch (selected_buff) {
+// Fills in the title and description shown for a buff option.
+static void SetBuffOption(BuffOption* option, BuffType type, int current_level) {
+    option->type = type;
+    switch (type) {
     case BUFF_LIFESTEAL:
-        player->has_lifesteal = true;
+        option->title = "Vampiric Strike";
+        snprintf(option->description, sizeof(option->description), "Heal for 50%% of damage you deal with Attack cards.");
         break;
     case BUFF_DESPERATE_DRAW:
-        player->has_desperate_draw = true;
-        break;
-    case BUFF_DIVINE_STRIKE:
-        player->has_divine_strike = true;
+        option->title = "Card Mastery";
+        snprintf(option->description, sizeof(option->description), "Draw 1 additional card at the start of each turn.");
         break;
     case BUFF_SHIELD_BOOST:
-        player->has_shield_boost = true;
+        option->title = "Reinforce";
+        snprintf(option->description, sizeof(option->description), "Permanently increase all Shield gains by 25%%.");
         break;
-    case BUFF_ATTACK_UP:
-        // --- Use scaling value ---
-        player->attack += attack_gain;
-        break;
-        // --- Added Lvl 6 Buffs ---
     case BUFF_ATTACK_BOOST_35:
-        player->has_attack_boost_35 = true;
+        option->title = "Power Infusion";
+        snprintf(option->description, sizeof(option->description), "All Attack cards are permanently 35%% stronger.");
         break;
     case BUFF_HEAL_BOOST_35:
-        player->has_heal_boost_35 = true;
+        option->title = "Holy Infusion";
+        snprintf(option->description, sizeof(option->description), "All Heal cards are permanently 35%% stronger.");
         break;
     case BUFF_SHIELD_BOOST_35:
-        player->has_shield_boost_35 = true;
+        option->title = "Barrier Infusion";
+        snprintf(option->description, sizeof(option->description), "All Shield cards are permanently 35%% stronger.");
+        break;
+    case BUFF_ATTACK_UP:
+        option->title = "Rage";
+        snprintf(option->description, sizeof(option->description), "Permanently increase your base Attack by %d.", Progression_BuffAttackGain(current_level));
+        break;
+    case BUFF_DIVINE_STRIKE:
+        option->title = "Divine Strike";
+        snprintf(option->description, sizeof(option->description), "Heal cards also deal 50%% of the heal as damage to all enemies.");
         break;
     case BUFF_NONE:
-        // Do nothing
+        option->title = "";
+        option->description[0] = '\0';
         break;
     }
 }
@@ -77,7 +79,7 @@ void InitBuffReward(BuffRewardState* state) {
     state->show_confirm_button = false;
 
     if (!font_loaded) {
-        buff_font = CP_Font_Load("Assets/Roboto-Regular.ttf");
+        buff_font = Asset_Font(Asset_Acquire(ASSET_FONT, "Assets/Roboto-Regular.ttf")); // Held for the session
         font_loaded = true;
     }
 
@@ -100,56 +102,14 @@ void InitBuffReward(BuffRewardState* state) {
 void GenerateBuffOptions(BuffRewardState* state, int current_level) {
     if (!state) return;
 
-    // --- Calculate scaling buff amounts ---
-    int boss_count = (current_level / 3) - 1; // Lvl 3 -> 0, Lvl 6 -> 1, Lvl 9 -> 2
-    int attack_gain = 2 + (1 * boss_count);
-
-
     // --- Different buffs for Lvl 3, 6, and 9 ---
-    if (current_level == 3) {
-        // --- Lvl 3 Buffs ---
-        state->options[0].type = BUFF_LIFESTEAL;
-        state->options[0].title = "Vampiric Strike";
-        snprintf(state->options[0].description, sizeof(state->options[0].description), "Heal for 50%% of damage you deal with Attack cards.");
-
-        state->options[1].type = BUFF_DESPERATE_DRAW;
-        state->options[1].title = "Card Mastery";
-        snprintf(state->options[1].description, sizeof(state->options[1].description), "Draw 1 additional card at the start of each turn.");
-
-        state->options[2].type = BUFF_SHIELD_BOOST;
-        state->options[2].title = "Reinforce";
-        snprintf(state->options[2].description, sizeof(state->options[2].description), "Permanently increase all Shield gains by 25%%.");
-    }
-    else if (current_level == 6) {
-        // --- Lvl 6 Buffs ---
-        state->options[0].type = BUFF_ATTACK_BOOST_35;
-        state->options[0].title = "Power Infusion";
-        snprintf(state->options[0].description, sizeof(state->options[0].description), "All Attack cards are permanently 35%% stronger.");
-
-        state->options[1].type = BUFF_HEAL_BOOST_35;
-        state->options[1].title = "Holy Infusion";
-        snprintf(state->options[1].description, sizeof(state->options[1].description), "All Heal cards are permanently 35%% stronger.");
-
-        state->options[2].type = BUFF_SHIELD_BOOST_35;
-        state->options[2].title = "Barrier Infusion";
-        snprintf(state->options[2].description, sizeof(state->options[2].description), "All Shield cards are permanently 35%% stronger.");
-    }
-    else {
-        // --- Lvl 9 Buffs ---
-        state->options[0].type = BUFF_LIFESTEAL;
-        state->options[0].title = "Vampiric Strike";
-        snprintf(state->options[0].description, sizeof(state->options[0].description), "Heal for 50%% of damage you deal with Attack cards.");
-
-        state->options[1].type = BUFF_DESPERATE_DRAW;
-        state->options[1].title = "Card Mastery";
-        snprintf(state->options[1].description, sizeof(state->options[1].description), "Draw 1 additional card at the start of each turn.");
-
-        state->options[2].type = BUFF_ATTACK_UP;
-        state->options[2].title = "Rage";
-        snprintf(state->options[2].description, sizeof(state->options[2].description), "Permanently increase your base Attack by %d.", attack_gain);
+    BuffType choices[MAX_BUFF_OPTIONS];
+    Progression_GetBuffChoices(current_level, choices);
+    for (int i = 0; i < MAX_BUFF_OPTIONS; i++) {
+        SetBuffOption(&state->options[i], choices[i], current_level);
     }
 
-    state->num_options = 3;
+    state->num_options = MAX_BUFF_OPTIONS;
     state->is_active = true;
     state->reward_claimed = false;
     state->selected_index = -1;
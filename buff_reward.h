@@ -2,20 +2,7 @@
 #pragma once
 #include "cprocessing.h"
 #include <stdbool.h>
-
-typedef struct Player Player;
-
-typedef enum {
-    BUFF_NONE,
-    BUFF_LIFESTEAL,
-    BUFF_DESPERATE_DRAW,
-    BUFF_DIVINE_STRIKE,
-    BUFF_SHIELD_BOOST,
-    BUFF_ATTACK_UP,
-    BUFF_ATTACK_BOOST_35,
-    BUFF_HEAL_BOOST_35,
-    BUFF_SHIELD_BOOST_35
-} BuffType;
+#include "progression.h"
 
 typedef struct {
     BuffType type;
@@ -23,7 +10,7 @@ typedef struct {
     char description[200];
 } BuffOption;
 
-#define MAX_BUFF_OPTIONS 3
+#define MAX_BUFF_OPTIONS BOSS_BUFF_OPTIONS
 
 typedef struct {
     BuffOption options[MAX_BUFF_OPTIONS];
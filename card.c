@@ -1,56 +1,80 @@
 #include "cprocessing.h"
 #include "card.h"
+#include "deck.h"
+#include "shuffle.h"
 #include "utils.h"
 #include "levels.h"
 #include "game.h"	
+#include "progression.h"
+#include "sprite.h"
+#include "platform.h"
+#include "zobrist.h"
 #include <stdio.h>
+#include <stdlib.h>
 #include <math.h>
 #include <string.h>
 
 // for the cataloguing of cards
-Card catalogue[50];
-int catalogue_size;
+CardCatalogue catalogue;
 
 
-// Static storage for icon assets
-static CP_Image icon_attack = NULL;
-static CP_Image icon_heal = NULL;
-static CP_Image icon_shield = NULL;
-
 // deck.c handles InitDeck, AddCardToDeck, etc. now.
 // Matching scale factor again
 #define CARD_SCALE 1.5f
 
+// Cards the game deals itself. "{value}" is filled in with power + the player's bonus when drawn,
+// so rewards never have to rewrite any text.
+static const struct {
+    CardType type;
+    CardEffect effect;
+    int power;
+    const char* text;
+} builtin_cards[] = {
+    { Attack, None, BASIC_ATTACK_POWER, "Deal {value} Dmg." },
+    { Heal, None, BASIC_HEAL_POWER, "Heal {value} HP." },
+    { Shield, None, BASIC_SHIELD_POWER, "Gain {value} Shield." },
+    { Attack, CLEAVE, CLEAVE_POWER, "Cleave:\n{value} Dmg (AOE)" },
+    { Heal, DIVINE_STRIKE_EFFECT, DIVINE_POWER, "Divine:\nHeal {value}\n50% Dmg (AOE)" },
+    { Shield, SHIELD_BASH, BASH_POWER, "Bash:\nGain {value} Shield\n Damage dealt = Shield" },
+};
+
+void RegisterBuiltinCards(void) {
+    for (int i = 0; i < (int)(sizeof(builtin_cards) / sizeof(builtin_cards[0])); i++) {
+        CardDef_Register(builtin_cards[i].type, builtin_cards[i].effect, builtin_cards[i].power, builtin_cards[i].text);
+    }
+}
+
 // --- DrawCard function ---
-void DrawCard(Card* hand) {
-    // --- 1. Lazy Load Assets ---
-    if (icon_attack == NULL) icon_attack = CP_Image_Load("Assets/icon_sword.png");
-    if (icon_heal == NULL)   icon_heal = CP_Image_Load("Assets/icon_heart.png");
-    if (icon_shield == NULL) icon_shield = CP_Image_Load("Assets/icon_shield.png");
+void DrawCard(Card* hand, const Player* player) {
+    CardType type = CardDef_Get(hand->id)->type;
+    DrawCardWithText(hand, CardDef_Text(hand->id, Progression_CardBonus(player, type)));
+}
 
-    // --- 2. Determine Color & Icon based on Type ---
+// Draws the whole face of a card the slow way: body, image area, icon and word-wrapped description.
+static void DrawCardFace(const Card* hand, const char* description) {
+    // --- 1. Determine Color & Icon based on Type ---
     CP_Color type_color;
-    CP_Image current_icon = NULL;
+    SpriteId current_icon = SPRITE_NONE;
 
-    switch (hand->type) {
+    switch (CardDef_Get(hand->id)->type) {
     case Attack:
         type_color = CP_Color_Create(255, 0, 0, 255); // Red
-        current_icon = icon_attack;
+        current_icon = SPRITE_ICON_SWORD;
         break;
     case Heal:
         type_color = CP_Color_Create(80, 172, 85, 255); // Green
-        current_icon = icon_heal;
+        current_icon = SPRITE_ICON_HEART;
         break;
     case Shield:
         type_color = CP_Color_Create(0, 0, 255, 255); // Blue
-        current_icon = icon_shield;
+        current_icon = SPRITE_ICON_SHIELD;
         break;
     default:
         type_color = CP_Color_Create(100, 100, 100, 255); // Gray fallback
         break;
     }
 
-    // --- 3. Draw Card Body ---
+    // --- 2. Draw Card Body ---
     CP_Settings_Fill(CP_Color_Create(50, 50, 50, 255)); // Dark Gray Background
 
     CP_Settings_Stroke(type_color); // Colored border based on type
@@ -64,7 +88,7 @@ void DrawCard(Card* hand) {
     float content_w = hand->card_w - (padding * 2);
     float total_h = hand->card_h - (padding * 2);
 
-    // --- 4. Top Image Area ---
+    // --- 3. Top Image Area ---
     float image_h = total_h * 0.50f;
     float image_center_y = (hand->pos.y - (hand->card_h / 2.0f)) + padding + (image_h / 2.0f);
 
@@ -73,13 +97,13 @@ void DrawCard(Card* hand) {
     CP_Settings_Stroke(CP_Color_Create(0, 0, 0, 255));
     CP_Graphics_DrawRect(hand->pos.x, image_center_y, content_w, image_h);
 
-    // --- 5. Draw the Icon ---
-    if (current_icon != NULL) {
+    // --- 4. Draw the Icon ---
+    if (current_icon != SPRITE_NONE) {
         float icon_size = image_h * 0.8f;
-        CP_Image_Draw(current_icon, hand->pos.x, image_center_y, icon_size, icon_size, 255);
+        Sprite_Draw(current_icon, hand->pos.x, image_center_y, icon_size, icon_size, 255);
     }
 
-    // --- 6. Description Text Box (Bottom) ---
+    // --- 5. Description Text Box (Bottom) ---
     CP_Settings_Fill(CP_Color_Create(255, 255, 255, 255));
     CP_Settings_TextSize(13.0f);
     CP_Settings_TextAlignment(CP_TEXT_ALIGN_H_CENTER, CP_TEXT_ALIGN_V_TOP);
@@ -87,13 +111,116 @@ void DrawCard(Card* hand) {
 
     float text_y_start = image_center_y + (image_h / 2.0f) + padding;
 
-    CP_Font_DrawTextBox(hand->description, hand->pos.x - (content_w / 2.0f), text_y_start, content_w);
+    CP_Font_DrawTextBox(description, hand->pos.x - (content_w / 2.0f), text_y_start, content_w);
 
     // Reset stroke
     CP_Settings_StrokeWeight(1.0f);
     CP_Settings_Stroke(CP_Color_Create(0, 0, 0, 255));
 }
 
+// --- Card face cache ---
+// Laying out the description is most of the cost of drawing a card, and a face only changes when
+// its text does. Each face is baked once into an image and blitted after that. CProcessing has no
+// offscreen targets, so BakeCardFaces draws the face into the back buffer before the frame clears
+// it and reads the region back with CP_Image_Screenshot.
+
+#define CARD_FACE_CACHE_SIZE 32
+#define CARD_FACE_BAKES_PER_FRAME 4 // Bounds the cost of a frame that meets many new faces
+#define CARD_FACE_MARGIN 2          // Pixels kept around the card for its border stroke
+
+typedef struct {
+    CardId id;
+    int w, h;                  // Card size in whole pixels
+    uint32_t text_hash;        // Description the face is (or will be) baked with
+    CP_Image image;            // NULL until the first bake
+    bool pending;              // Needs a (re)bake in the next BakeCardFaces
+    char text[CARD_DESC_SIZE]; // Copy of the description for the bake
+    unsigned last_used;
+} CardFace;
+
+static CardFace card_faces[CARD_FACE_CACHE_SIZE];
+static int card_face_count = 0;
+static unsigned card_face_clock = 0;
+
+static uint32_t HashText(const char* text) {
+    uint32_t hash = 2166136261u; // FNV-1a
+    for (const unsigned char* p = (const unsigned char*)text; *p; p++) {
+        hash = (hash ^ *p) * 16777619u;
+    }
+    return hash;
+}
+
+// Returns the cache entry for the definition at this size, recycling the least recently used one if needed.
+static CardFace* FindCardFace(CardId id, int w, int h) {
+    CardFace* oldest = NULL;
+    for (int i = 0; i < card_face_count; i++) {
+        CardFace* face = &card_faces[i];
+        if (face->id == id && face->w == w && face->h == h) return face;
+        if (!oldest || face->last_used < oldest->last_used) oldest = face;
+    }
+
+    CardFace* face = (card_face_count < CARD_FACE_CACHE_SIZE) ? &card_faces[card_face_count++] : oldest;
+    if (face->image) CP_Image_Free(face->image);
+    memset(face, 0, sizeof(*face));
+    face->id = id;
+    face->w = w;
+    face->h = h;
+    return face;
+}
+
+void DrawCardWithText(Card* hand, const char* description) {
+    int w = (int)(hand->card_w + 0.5f);
+    int h = (int)(hand->card_h + 0.5f);
+    uint32_t text_hash = HashText(description);
+
+    CardFace* face = FindCardFace(hand->id, w, h);
+    face->last_used = ++card_face_clock;
+    if (face->image && !face->pending && face->text_hash == text_hash) {
+        Sprite_DrawImage(face->image, hand->pos.x, hand->pos.y,
+            (float)(w + CARD_FACE_MARGIN * 2), (float)(h + CARD_FACE_MARGIN * 2), 255);
+        return;
+    }
+
+    // New face or its description changed: draw it directly this frame and bake it before the next
+    if (face->text_hash != text_hash || !face->pending) {
+        face->text_hash = text_hash;
+        snprintf(face->text, sizeof(face->text), "%s", description);
+        face->pending = true;
+    }
+    DrawCardFace(hand, description);
+}
+
+void BakeCardFaces(void) {
+    int baked = 0;
+    for (int i = 0; i < card_face_count && baked < CARD_FACE_BAKES_PER_FRAME; i++) {
+        CardFace* face = &card_faces[i];
+        if (!face->pending) continue;
+
+        // Transparent around the card where the back buffer keeps alpha
+        CP_Graphics_ClearBackground(CP_Color_Create(0, 0, 0, 0));
+        Card card;
+        memset(&card, 0, sizeof(card));
+        card.id = face->id;
+        card.card_w = (float)face->w;
+        card.card_h = (float)face->h;
+        card.pos = CP_Vector_Set(CARD_FACE_MARGIN + face->w / 2.0f, CARD_FACE_MARGIN + face->h / 2.0f);
+        DrawCardFace(&card, face->text);
+
+        if (face->image) CP_Image_Free(face->image);
+        face->image = CP_Image_Screenshot(0, 0, face->w + CARD_FACE_MARGIN * 2, face->h + CARD_FACE_MARGIN * 2);
+        face->pending = false;
+        baked++;
+    }
+}
+
+void FreeCardFaces(void) {
+    for (int i = 0; i < card_face_count; i++) {
+        if (card_faces[i].image) CP_Image_Free(card_faces[i].image);
+    }
+    memset(card_faces, 0, sizeof(card_faces));
+    card_face_count = 0;
+}
+
 void SelectCard(int index, int* selected) {
     // if current card index is selected index
     if (*selected == index) {
@@ -170,25 +297,42 @@ void SetHandPos(Card* hand, int hand_size) {
     }
 }
 
-void ShuffleDeck(Deck* deck) {
+void ShuffleDeck(Deck* deck, Rng* rng) {
+    // draw every swap partner up front (vectorized, see shuffle.c)
+    uint8_t swaps[SHUFFLE_MAX_SIZE];
+    Shuffle_Draws(rng, deck->size, swaps);
+
     // shuffles from the back
     for (int i = deck->size - 1; i > 0; i--) {
         // get an index from the cards before current index.
         // will not touch already shuffled cards and cards will not stay in space
-        int j = CP_Random_RangeInt(0, i);
-        // swap
-        Card temp = deck->cards[i];
-        deck->cards[i] = deck->cards[j];
-        deck->cards[j] = temp;
+        int j = swaps[i];
+        // swap the slot indices in the draw pile ring, the cards themselves never move
+        uint8_t* a = &deck->order[(deck->head + i) & (DECK_RING_SIZE - 1)];
+        uint8_t* b = &deck->order[(deck->head + j) & (DECK_RING_SIZE - 1)];
+        uint8_t temp = *a;
+        *a = *b;
+        *b = temp;
     }
 }
 
-void DealFromDeck(Deck* deck, Card* hand_slot, int* hand_size) {
-    // if deck is empty terminate the fucntion call
-    if (deck->size <= 0) return;
+uint64_t CardHashKey(CardId id) {
+    const CardDef* def = CardDef_Get(id);
+    return Zobrist_CardKey(def->type, def->effect, def->power);
+}
+
+void DealFromDeck(Deck* deck, Card* hand_slot, int* hand_size, uint64_t* hand_hash) {
+    // take the top card; if deck is empty terminate the fucntion call
+    int slot = DrawFromDeck(deck);
+    if (slot < 0) return;
 
     // deal the card to the current hand index through pointer
-    *hand_slot = deck->cards[0];
+    hand_slot->id = deck->cards[slot];
+    hand_slot->deck_slot = (uint8_t)slot;
+    hand_slot->card_w = CARD_W_INIT * CARD_SCALE;
+    hand_slot->card_h = CARD_H_INIT * CARD_SCALE;
+    hand_slot->target_pos = CP_Vector_Set(0.0f, 0.0f);
+    hand_slot->is_discarding = false;
 
     CP_Vector deck_pos_center = CP_Vector_Set(
         50.0f + (CARD_W_INIT * 1.5f) / 2.0f,
@@ -196,57 +340,40 @@ void DealFromDeck(Deck* deck, Card* hand_slot, int* hand_size) {
     );
     // set the hand pos to deck so it draws from deck and will move to hand slot position
     hand_slot->pos = deck_pos_center;
+    hand_slot->prev_pos = deck_pos_center;
     hand_slot->is_animating = true;
 
-    // move cards in deck up a slot for next draw
-    for (int i = 0; i < deck->size - 1; ++i) {
-        deck->cards[i] = deck->cards[i + 1];
-    }
-
-    // update deck and hand size
-    --(deck->size);
+    // update hand size (DrawFromDeck already advanced the draw pile)
     ++(*hand_size);
+    if (hand_hash) *hand_hash += CardHashKey(hand_slot->id);
 }
 
-void RecycleDeck(Card* discard, Deck* deck, int* discard_size) {
-    CP_Vector deck_pos_topleft = CP_Vector_Set(50.0f, 600.0f);
-    CP_Vector deck_pos_center = CP_Vector_Set(
-        deck_pos_topleft.x + CARD_W_INIT / 2.0f,
-        deck_pos_topleft.y + CARD_H_INIT / 2.0f
-    );
-
+void RecycleDeck(Card* discard, Deck* deck, int* discard_size, Rng* rng) {
     for (int i = 0; i < *discard_size; ++i) {
-        // pass cards from discard pile to last slot in deck
-        deck->cards[deck->size] = discard[i];
-        deck->cards[deck->size].pos = deck_pos_center;
-
-        deck->cards[deck->size].is_discarding = false;
-        deck->cards[deck->size].is_animating = false;
-        deck->cards[deck->size].target_pos = CP_Vector_Set(0.0f, 0.0f);
-
-        // increment deck size
-        ++(deck->size);
+        // pass the card's slot from discard pile to the bottom of the deck; DealFromDeck resets its position
+        ReturnCardToDeck(deck, &discard[i]);
     }
     // set discard size to zero as there is no more cards
     *discard_size = 0;
 
-    ShuffleDeck(deck);
+    ShuffleDeck(deck, rng);
 }
 
-void AnimateMoveCard(Card* hand, float speed) {
-    // get dt value to animate according to frame rate
-    float dt = CP_System_GetDt();
+void AnimateMoveCard(Card* hand, float speed, float dt) {
+    // remember where the card was so rendering can interpolate between ticks
+    hand->prev_pos = hand->pos;
 
     // get relative direction to target location and distance to location 
     CP_Vector direction = CP_Vector_Subtract(hand->target_pos, hand->pos);
     float distance = CP_Vector_Length(direction);
 
-    // set move vector to a scaled vector of the unit vector of the direction and the speed scaled by delta time
+    // set move vector to a scaled vector of the unit vector of the direction and the speed scaled by the tick length
     CP_Vector move = CP_Vector_Scale(CP_Vector_Normalize(direction), speed * dt);
 
     // if the movement vector is more than the distance just snap the card to postion
     if (CP_Vector_Length(move) > distance) {
         hand->pos = hand->target_pos;
+        hand->prev_pos = hand->target_pos; // at rest, so the next animation starts from here
         hand->is_animating = false;
     }
     else {
@@ -255,67 +382,175 @@ void AnimateMoveCard(Card* hand, float speed) {
     }
 }
 
-// to parse stirng taken from catalogue file into a effect type
-CardEffect StringToEffect(const char* s) {
-    if (strcmp(s, "Draw") == 0) return Draw;
-    if (strcmp(s, "SHIELD_BASH") == 0) return SHIELD_BASH;
-    if (strcmp(s, "CLEAVE") == 0) return CLEAVE;
-    if (strcmp(s, "DIVINE_STRIKE_EFFECT") == 0) return DIVINE_STRIKE_EFFECT;
-    return None;
+CP_Vector GetCardDrawPos(const Card* card, float alpha) {
+    if (!card->is_animating) return card->pos;
+    return CP_Vector_Set(card->prev_pos.x + (card->pos.x - card->prev_pos.x) * alpha,
+        card->prev_pos.y + (card->pos.y - card->prev_pos.y) * alpha);
+}
+
+// --- Catalogue loading ---
+// The catalogue holds one card per line:
+//     Type,Effect,Power,Description
+// Type is Attack, Heal or Shield; Effect is a CardEffect name (None, Draw, CLEAVE, ...); Power is a
+// whole number; the description runs to the end of the line and may use {value}. Blank lines and
+// lines starting with '#' are skipped. The file is mapped and scanned in place, and a malformed line
+// is reported with its line and column, then skipped.
+
+#define CATALOGUE_MAX_ERRORS 10 // Reported per file; the rest are only counted
+#define CATALOGUE_MAX_POWER 1000000
+
+// Names as written in the file, indexed by enum value
+static const char* const type_names[] = { "Attack", "Heal", "Shield" };
+static const char* const effect_names[] = { "None", "Draw", "Fire", "Poison", "SHIELD_BASH", "CLEAVE", "DIVINE_STRIKE_EFFECT" };
+
+// A slice of the mapped file (not NUL-terminated)
+typedef struct {
+    const char* text;
+    int length;
+} CatalogueField;
+
+typedef struct {
+    const char* path;
+    const char* line_start;
+    int line;
+    int errors;
+} CatalogueScan;
+
+// Prints "path:line:column: message" for the character at, followed by field if it has text.
+static void ReportCatalogueError(CatalogueScan* scan, const char* at, const char* message, CatalogueField field) {
+    if (++scan->errors > CATALOGUE_MAX_ERRORS) return;
+    printf("%s:%d:%d: %s", scan->path, scan->line, (int)(at - scan->line_start) + 1, message);
+    if (field.text) printf(" '%.*s'", field.length, field.text);
+    printf("\n");
+}
+
+static bool IsBlank(char c) {
+    return c == ' ' || c == '\t' || c == '\r';
 }
 
-// to parse stirng taken from catalogue file into a Card type
-CardType StringToType(const char* s) {
-    if (strcmp(s, "Attack") == 0) return Attack;
-    if (strcmp(s, "Heal") == 0) return Heal;
-    if (strcmp(s, "Shield") == 0) return Shield;
-    return Attack;
+// Returns [begin, end) without surrounding blanks.
+static CatalogueField TrimField(const char* begin, const char* end) {
+    while (begin < end && IsBlank(*begin)) begin++;
+    while (end > begin && IsBlank(end[-1])) end--;
+    CatalogueField field = { begin, (int)(end - begin) };
+    return field;
 }
 
-int LoadCatalogue(const char* fcat, Card* cat_arr, int max_size) {
-    // load file
-    FILE* catalogue_file = fopen(fcat, "r");
-    // if cannot open we read 0 cards so return 0
-    if (!catalogue_file) {
-        return 0;
+// Returns the index of the name matching field, or -1.
+static int FindName(CatalogueField field, const char* const* names, int count) {
+    for (int i = 0; i < count; i++) {
+        if (strncmp(names[i], field.text, (size_t)field.length) == 0 && names[i][field.length] == '\0') return i;
     }
+    return -1;
+}
+
+static bool ParsePower(CatalogueField field, int* out) {
+    const char* c = field.text;
+    const char* end = field.text + field.length;
+    bool negative = c < end && *c == '-';
+    if (c < end && (*c == '-' || *c == '+')) c++;
+    if (c == end) return false;
+    int value = 0;
+    for (; c < end; c++) {
+        if (*c < '0' || *c > '9') return false;
+        value = value * 10 + (*c - '0');
+        if (value > CATALOGUE_MAX_POWER) return false;
+    }
+    *out = negative ? -value : value;
+    return true;
+}
 
-    // variables to store data
-    char string[255];
-    char type[30];
-    char effect[30];
-    char desc[200];
-
-    // card read count
-    int count = 0;
-
-    // get line by line until EOF and card count not max than max number of elenments in the array
-    while (fgets(string, 255, catalogue_file) != NULL && count < max_size) {
-        // scan the line for the attributes of card struct
-        sscanf_s(string, "%29[^,],%29[^,],%d,%198[^\n]", //all takes in one less character to accomodate null termination
-            type, (unsigned int)sizeof(type),
-            effect, (unsigned int)sizeof(effect),
-            &cat_arr[count].power,
-            desc, (unsigned int)sizeof(desc));
-
-        // force desc to be null terminated
-        desc[199] = '\0';
-        
-        // set the attribute to a element in the array of type Card
-        cat_arr[count].type = StringToType(type);
-        cat_arr[count].effect = StringToEffect(effect);
-        strcpy_s(cat_arr[count].description, sizeof(cat_arr[count].description), desc);
-        cat_arr[count].pos = cat_arr[count].target_pos = CP_Vector_Set(0.0f, 0.0f);
-        cat_arr[count].is_animating = false;
-        cat_arr[count].is_discarding = false;
-        cat_arr[count].card_h = CARD_H_INIT;
-        cat_arr[count].card_w = CARD_W_INIT;
-        // increment the card
-        count++;
+static bool AppendToCatalogue(CardCatalogue* table, CardId id) {
+    if (table->count == table->capacity) {
+        int capacity = table->capacity ? table->capacity * 2 : 64;
+        CardId* grown = realloc(table->ids, sizeof(CardId) * (size_t)capacity);
+        if (!grown) return false;
+        table->ids = grown;
+        table->capacity = capacity;
     }
+    table->ids[table->count++] = id;
+    return true;
+}
+
+// Parses one line (without its newline) and registers the card. Returns false if loading has to stop.
+static bool ScanCatalogueLine(CatalogueScan* scan, const char* begin, const char* end, CardCatalogue* table) {
+    static const CatalogueField no_field = { NULL, 0 };
+    CatalogueField line = TrimField(begin, end);
+    if (line.length == 0 || line.text[0] == '#') return true;
+
+    // Split off the first three fields; the description is everything after the third comma
+    CatalogueField fields[3];
+    const char* cursor = begin;
+    for (int i = 0; i < 3; i++) {
+        const char* comma = memchr(cursor, ',', (size_t)(end - cursor));
+        if (!comma) {
+            ReportCatalogueError(scan, line.text + line.length, "expected Type,Effect,Power,Description", no_field);
+            return true;
+        }
+        fields[i] = TrimField(cursor, comma);
+        cursor = comma + 1;
+    }
+    CatalogueField description = TrimField(cursor, end);
+
+    int type = FindName(fields[0], type_names, (int)(sizeof(type_names) / sizeof(type_names[0])));
+    int effect = FindName(fields[1], effect_names, (int)(sizeof(effect_names) / sizeof(effect_names[0])));
+    int power;
+    if (type < 0) { ReportCatalogueError(scan, fields[0].text, "unknown card type", fields[0]); return true; }
+    if (effect < 0) { ReportCatalogueError(scan, fields[1].text, "unknown card effect", fields[1]); return true; }
+    if (!ParsePower(fields[2], &power)) { ReportCatalogueError(scan, fields[2].text, "power is not a number", fields[2]); return true; }
+    if (description.length >= CARD_DESC_SIZE) {
+        ReportCatalogueError(scan, description.text + CARD_DESC_SIZE - 1, "description is too long", no_field);
+        return true;
+    }
+
+    // The definition table keeps its own copy; this is the only time the text leaves the mapping
+    char text[CARD_DESC_SIZE];
+    memcpy(text, description.text, (size_t)description.length);
+    text[description.length] = '\0';
+
+    CardId id = CardDef_Register((CardType)type, (CardEffect)effect, power, text);
+    if (id == CARD_ID_NONE) {
+        ReportCatalogueError(scan, line.text, "card table is full", no_field);
+        return false;
+    }
+    if (!AppendToCatalogue(table, id)) {
+        ReportCatalogueError(scan, line.text, "out of memory", no_field);
+        return false;
+    }
+    return true;
+}
+
+int LoadCatalogue(const char* fcat, CardCatalogue* table) {
+    // built-in cards go first so a catalogue line for the same card keeps the upgradeable text
+    RegisterBuiltinCards();
+    if (!table) return 0;
+    table->count = 0;
+
+    // a missing (or empty) file loads no cards
+    PlatformMappedFile file;
+    if (!Platform_MapFile(fcat, &file)) return 0;
+
+    const char* cursor = (const char*)file.data;
+    const char* end = cursor + file.size;
+    if (file.size >= 3 && memcmp(cursor, "\xEF\xBB\xBF", 3) == 0) cursor += 3; // UTF-8 byte order mark
+
+    CatalogueScan scan = { fcat, cursor, 0, 0 };
+    while (cursor < end) {
+        const char* newline = memchr(cursor, '\n', (size_t)(end - cursor));
+        const char* line_end = newline ? newline : end;
+        scan.line++;
+        scan.line_start = cursor;
+        if (!ScanCatalogueLine(&scan, cursor, line_end, table)) break;
+        cursor = newline ? newline + 1 : end;
+    }
+
+    Platform_UnmapFile(&file);
+    if (scan.errors > CATALOGUE_MAX_ERRORS) printf("%s: %d more errors\n", fcat, scan.errors - CATALOGUE_MAX_ERRORS);
+    return table->count;
+}
 
-    // close the file
-    fclose(catalogue_file);
-    // return number of card read
-    return count;
+void FreeCatalogue(CardCatalogue* table) {
+    if (!table) return;
+    free(table->ids);
+    memset(table, 0, sizeof(*table));
 }
\ No newline at end of file
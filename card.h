@@ -2,55 +2,65 @@
 #pragma once
 #include "cprocessing.h"
 #include <stdbool.h>
+#include <stdint.h>
 #include "levels.h"
+#include "carddef.h"
+#include "rng.h"
 
 #define CARD_W_INIT 60
 #define CARD_H_INIT 90
 #define MAX_DECK_SIZE 25
+#define DECK_RING_SIZE 32 // Power of two >= MAX_DECK_SIZE, so draw pile positions wrap with a mask
 
 // Forward declare Player
 typedef struct Player Player;
 
-typedef enum {
-	Attack,
-	Heal,
-	Shield,
-} CardType;
-
-typedef enum {
-	None,
-	Draw,
-	Fire,
-	Poison,
-	SHIELD_BASH,
-	CLEAVE,
-	DIVINE_STRIKE_EFFECT
-} CardEffect;
-
+// One card on screen (hand, discard pile, reward preview). What the card does lives in the
+// shared definition table (carddef.h); this only holds the id and the per-copy layout state.
 typedef struct Card {
 	CP_Vector pos;
+	CP_Vector prev_pos; // Position at the previous logic tick, for render interpolation
 	CP_Vector target_pos;
-	CardType type;
-	CardEffect effect;
-	int power;
-	char description[200];
 	float card_w;
 	float card_h;
+	CardId id;
+	uint8_t deck_slot; // Slot in the owning Deck's cards[] this card was dealt from
 	bool is_animating;
 	bool is_discarding;
 } Card;
 
+// Every card the player owns sits in a fixed slot of cards[]. The draw pile is a ring of slot
+// indices, so drawing, returning and shuffling move single bytes instead of whole cards.
 typedef struct Deck {
-	Card cards[MAX_DECK_SIZE];
-	int size;
+	CardId cards[MAX_DECK_SIZE];
+	uint32_t used_slots;           // Bit i is set while cards[i] holds an owned card
+	uint8_t order[DECK_RING_SIZE]; // Draw pile, top card at order[head]
+	int head;
+	int size;                      // Cards in the draw pile
 	int capacity;
 } Deck;
 
-extern Card catalogue[50];
-extern int catalogue_size;
+// Card ids read from a catalogue file, in file order. Grows as needed; free with FreeCatalogue.
+typedef struct {
+	CardId* ids;
+	int count;
+	int capacity;
+} CardCatalogue;
+
+extern CardCatalogue catalogue;
+
+// Renders the visual representation of the card pointed to by handptr to the screen, using the player's bonuses for its text.
+void DrawCard(Card* hand, const Player* player);
+
+// Renders the card like DrawCard but with the given text in place of its definition's description (reward previews).
+// Faces are cached per definition, size and text; a face seen for the first time is drawn directly until baked.
+void DrawCardWithText(Card* hand, const char* description);
 
-// Renders the visual representation of the card pointed to by handptr to the screen, using player context if needed.
-void DrawCard(Card* hand);
+// Bakes the card faces first seen since the last call. Call at the start of a frame, before the screen is cleared.
+void BakeCardFaces(void);
+
+// Frees every cached card face.
+void FreeCardFaces(void);
 
 // Toggles the selection state of the card at the specified index, updating the selected variable.
 void SelectCard(int index, int* selected);
@@ -62,16 +72,30 @@ float CalculateCardScale(int hand_size);
 void SetHandPos(Card* hand, int hand_size);
 
 // Moves a card from the deck to the specified hand_slot and increments the hand_size counter.
-void DealFromDeck(Deck* deck, Card* hand_slot, int* hand_size);
+// hand_hash, if not NULL, gets the card's CardHashKey added.
+void DealFromDeck(Deck* deck, Card* hand_slot, int* hand_size, uint64_t* hand_hash);
+
+// Returns the card's Zobrist hand key (Zobrist_CardKey of its type, effect and power); a hand's hash is the sum.
+uint64_t CardHashKey(CardId id);
+
+// Moves all cards from the discard pile back into the deck, resets the discard_size, and shuffles the deck with rng.
+void RecycleDeck(Card* discard, Deck* deck, int* discard_size, Rng* rng);
+
+// Moves the card towards its target position at the specified speed (pixels per second) for one logic tick of dt seconds.
+void AnimateMoveCard(Card* hand, float speed, float dt);
+
+// Returns where to draw the card: between its last two tick positions while it moves (alpha from Timestep_Alpha).
+CP_Vector GetCardDrawPos(const Card* card, float alpha);
 
-// Moves all cards from the discard pile back into the deck, resets the discard_size, and shuffles the deck.
-void RecycleDeck(Card* discard, Deck* deck, int* discard_size);
+// Randomizes the order of cards currently in the deck, drawing from rng (the run's shuffle stream).
+void ShuffleDeck(Deck* deck, Rng* rng);
 
-// Updates the card's current position to move towards its target position at the specified speed.
-void AnimateMoveCard(Card* hand, float speed);
+// Registers the cards the game deals itself (basics and reward specials) with their upgradeable text. Safe to call repeatedly.
+void RegisterBuiltinCards(void);
 
-// Randomizes the order of cards currently in the deck.
-void ShuffleDeck(Deck* deck);
+// Registers the card definitions in the text file (fcat) and stores their ids in table, replacing what it held.
+// Malformed lines are reported as "file:line:column: problem" and skipped. Returns the number of cards loaded.
+int LoadCatalogue(const char* fcat, CardCatalogue* table);
 
-// Loads card definitions from the text file (fcat) into the catalogue array (cat_arr). Returns the number of cards loaded.
-int LoadCatalogue(const char* fcat, Card* cat_arr, int max_size);
\ No newline at end of file
+// Frees the table's ids and empties it.
+void FreeCatalogue(CardCatalogue* table);
\ No newline at end of file
@@ -0,0 +1,152 @@
+// @file carddef.c
+// @brief Card definition table and the formatted-description cache.
+//
+// Descriptions are stored once per card kind as templates. Upgrades only change the player's bonus,
+// so nothing is rewritten on a reward; the text is formatted when a card is drawn and the result is
+// kept in an LRU cache keyed by (template, value). The simulator never formats text.
+//
+// Definitions live in fixed-size pages allocated as the table grows, so their addresses (and the
+// cache's template pointers) never change. A hash index over (type, effect, power) keeps lookups
+// constant-time for catalogues with thousands of cards.
+
+#include "carddef.h"
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CARD_TEXT_PLACEHOLDER "{value}"
+#define CARD_DEF_PAGE_SIZE 64
+#define CARD_DEF_PAGE_COUNT (CARD_DEF_MAX / CARD_DEF_PAGE_SIZE)
+
+typedef struct {
+    const char* text; // Template the entry was formatted from (NULL = empty entry)
+    int value;
+    unsigned int last_used;
+    char formatted[CARD_DESC_SIZE];
+} CardTextEntry;
+
+static CardDef* def_pages[CARD_DEF_PAGE_COUNT];
+static int def_count;
+
+// Open-addressing index: slots hold id + 1 (0 = empty), at most half full
+static uint16_t* index_slots;
+static uint32_t index_mask;
+
+static CardTextEntry text_cache[CARD_TEXT_CACHE_SIZE];
+static unsigned int text_clock;
+
+static const CardDef invalid_def = { Attack, None, 0, "Invalid" };
+
+static CardDef* DefAt(int id) {
+    return &def_pages[id / CARD_DEF_PAGE_SIZE][id % CARD_DEF_PAGE_SIZE];
+}
+
+static uint32_t HashKind(CardType type, CardEffect effect, int power) {
+    uint32_t h = (uint32_t)power * 0x9E3779B1u ^ ((uint32_t)type << 8 | (uint32_t)effect) * 0x85EBCA77u;
+    return h ^ (h >> 15);
+}
+
+// Puts id into the index. The index must have a free slot.
+static void IndexInsert(CardId id) {
+    const CardDef* def = DefAt(id);
+    uint32_t slot = HashKind(def->type, def->effect, def->power) & index_mask;
+    while (index_slots[slot]) slot = (slot + 1) & index_mask;
+    index_slots[slot] = (uint16_t)(id + 1);
+}
+
+// Doubles the index (or creates it) and re-inserts every definition. Returns false when out of memory.
+static bool GrowIndex(void) {
+    uint32_t capacity = index_slots ? (index_mask + 1) * 2 : 128;
+    uint16_t* slots = calloc(capacity, sizeof(uint16_t));
+    if (!slots) return false;
+    free(index_slots);
+    index_slots = slots;
+    index_mask = capacity - 1;
+    for (int i = 0; i < def_count; i++) IndexInsert((CardId)i);
+    return true;
+}
+
+CardId CardDef_Find(CardType type, CardEffect effect, int power) {
+    if (!index_slots) return CARD_ID_NONE;
+    uint32_t slot = HashKind(type, effect, power) & index_mask;
+    for (; index_slots[slot]; slot = (slot + 1) & index_mask) {
+        CardId id = (CardId)(index_slots[slot] - 1);
+        const CardDef* def = DefAt(id);
+        if (def->type == type && def->effect == effect && def->power == power) return id;
+    }
+    return CARD_ID_NONE;
+}
+
+CardId CardDef_Register(CardType type, CardEffect effect, int power, const char* description) {
+    CardId id = CardDef_Find(type, effect, power);
+    if (id != CARD_ID_NONE) return id;
+    if (def_count >= CARD_DEF_MAX) return CARD_ID_NONE;
+    if ((uint32_t)(def_count + 1) * 2 > (index_slots ? index_mask + 1 : 0) && !GrowIndex()) return CARD_ID_NONE;
+
+    CardDef** page = &def_pages[def_count / CARD_DEF_PAGE_SIZE];
+    if (!*page) *page = malloc(sizeof(CardDef) * CARD_DEF_PAGE_SIZE);
+    if (!*page) return CARD_ID_NONE;
+
+    CardDef* def = DefAt(def_count);
+    def->type = type;
+    def->effect = effect;
+    def->power = power;
+    snprintf(def->description, sizeof(def->description), "%s", description ? description : "");
+    IndexInsert((CardId)def_count);
+    return (CardId)def_count++;
+}
+
+const CardDef* CardDef_Get(CardId id) {
+    if (id >= def_count) return &invalid_def;
+    return DefAt(id);
+}
+
+int CardDef_Count(void) {
+    return def_count;
+}
+
+// Copies text into out, replacing every {value} with the number.
+static void ExpandText(const char* text, int value, char* out, size_t out_size) {
+    size_t placeholder_len = strlen(CARD_TEXT_PLACEHOLDER);
+    size_t used = 0;
+    out[0] = '\0';
+    while (*text && used + 1 < out_size) {
+        if (strncmp(text, CARD_TEXT_PLACEHOLDER, placeholder_len) == 0) {
+            int written = snprintf(out + used, out_size - used, "%d", value);
+            if (written < 0) break;
+            used += (size_t)written;
+            if (used >= out_size) { used = out_size - 1; break; }
+            text += placeholder_len;
+            continue;
+        }
+        out[used++] = *text++;
+    }
+    out[used] = '\0';
+}
+
+const char* CardDef_FormatText(const char* text, int value) {
+    if (!text) return "";
+
+    CardTextEntry* oldest = &text_cache[0];
+    for (int i = 0; i < CARD_TEXT_CACHE_SIZE; i++) {
+        CardTextEntry* entry = &text_cache[i];
+        if (entry->text == text && entry->value == value) {
+            entry->last_used = ++text_clock;
+            return entry->formatted;
+        }
+        if (!entry->text || (oldest->text && entry->last_used < oldest->last_used)) oldest = entry;
+    }
+
+    // Miss: reuse the least recently used (or an empty) entry
+    oldest->text = text;
+    oldest->value = value;
+    oldest->last_used = ++text_clock;
+    ExpandText(text, value, oldest->formatted, sizeof(oldest->formatted));
+    return oldest->formatted;
+}
+
+const char* CardDef_Text(CardId id, int bonus) {
+    const CardDef* def = CardDef_Get(id);
+    return CardDef_FormatText(def->description, def->power + bonus);
+}
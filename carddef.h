@@ -0,0 +1,55 @@
+// Card type and effect enumerations, plus the shared table of card definitions that every card
+// instance points into by id. Kept free of CProcessing so the headless rules can use them.
+#pragma once
+#include <stdint.h>
+
+#define CARD_DEF_MAX 8192   // Distinct (type, effect, power) card kinds (modded catalogues can hold thousands)
+#define CARD_DESC_SIZE 200
+#define CARD_TEXT_CACHE_SIZE 32 // Formatted descriptions kept, least recently used dropped first
+#define CARD_ID_NONE ((CardId)0xFFFF)
+
+typedef uint16_t CardId;
+
+typedef enum {
+	Attack,
+	Heal,
+	Shield,
+} CardType;
+
+typedef enum {
+	None,
+	Draw,
+	Fire,
+	Poison,
+	SHIELD_BASH,
+	CLEAVE,
+	DIVINE_STRIKE_EFFECT
+} CardEffect;
+
+// What a card is, shared by every copy of it in the deck, hand and discard pile.
+typedef struct {
+	CardType type;
+	CardEffect effect;
+	int power;
+	char description[CARD_DESC_SIZE]; // Template: "{value}" stands for power plus the player's bonus
+} CardDef;
+
+// Returns the id for (type, effect, power), registering it with description if it's new. Returns CARD_ID_NONE if the table is full.
+CardId CardDef_Register(CardType type, CardEffect effect, int power, const char* description);
+
+// Returns the id for (type, effect, power), or CARD_ID_NONE if it was never registered.
+CardId CardDef_Find(CardType type, CardEffect effect, int power);
+
+// Returns the definition for id. Unknown ids give a placeholder "Invalid" card, never NULL.
+// Definitions never move, so the pointer stays valid while more cards are registered.
+const CardDef* CardDef_Get(CardId id);
+
+// Returns the number of registered definitions. Ids run from 0 to count - 1.
+int CardDef_Count(void);
+
+// Returns the card's description with {value} filled in as power + bonus. The string comes from a
+// small LRU cache and stays valid until CARD_TEXT_CACHE_SIZE other texts have been formatted.
+const char* CardDef_Text(CardId id, int bonus);
+
+// Fills in {value} in any long-lived template string (e.g. reward blurbs), through the same cache.
+const char* CardDef_FormatText(const char* text, int value);
@@ -0,0 +1,287 @@
+// @file combat.c
+// @brief Render-free combat rules. The game presents the emitted events; the simulator attaches no bus.
+
+#include "combat.h"
+#include "zobrist.h"
+#include "aoe.h"
+#include "eventbus.h"
+#include <stddef.h>
+
+// Reports an event to the attached bus. Without a listener this is a single branch.
+static void PushEvent(CombatState* state, CombatEventType type, CombatSource source, int target, int amount) {
+    if (!state->bus) return;
+    CombatEvent ev = { type, source, target, amount };
+    EventBus_Push(state->bus, &ev);
+}
+
+// --- State changes ---
+// Every write to a hashed field goes through these so the Zobrist hash stays in step.
+
+static void SetPlayerHealth(CombatState* state, int health) {
+    Zobrist_Update(&state->hash, ZOBRIST_PLAYER_HEALTH, 0, state->player->health, health);
+    state->player->health = health;
+}
+
+static void SetPlayerShield(CombatState* state, int shield) {
+    Zobrist_Update(&state->hash, ZOBRIST_PLAYER_SHIELD, 0, state->player->shield, shield);
+    state->player->shield = shield;
+}
+
+static void SetEnemyHealth(CombatState* state, int index, int health) {
+    Zobrist_Update(&state->hash, ZOBRIST_ENEMY_HEALTH, index, state->encounter->health[index], health);
+    state->encounter->health[index] = health;
+}
+
+static void SetEnemyShield(CombatState* state, int index, int shield) {
+    Zobrist_Update(&state->hash, ZOBRIST_ENEMY_SHIELD, index, state->encounter->shield[index], shield);
+    state->encounter->shield[index] = shield;
+}
+
+static void SetEnemyAttack(CombatState* state, int index, int attack) {
+    Zobrist_Update(&state->hash, ZOBRIST_ENEMY_ATTACK, index, state->encounter->attack[index], attack);
+    state->encounter->attack[index] = attack;
+}
+
+static void KillEnemy(CombatState* state, int index) {
+    if (!state->encounter->alive[index]) return;
+    Zobrist_Update(&state->hash, ZOBRIST_ENEMY_ALIVE, index, 1, 0);
+    state->encounter->alive[index] = 0;
+}
+
+// Applies damage to one enemy, shield first, then health. Returns the health damage dealt.
+// report_block emits a BLOCKED event when the shield absorbs everything (single-target hits only).
+static int DamageEnemy(CombatState* state, int index, int damage, CombatSource source, bool report_block) {
+    Encounter* enc = state->encounter;
+    int damage_blocked = 0;
+    int damage_dealt = 0;
+
+    // Shield mitigation
+    if (enc->shield[index] > 0) {
+        damage_blocked = (damage <= enc->shield[index]) ? damage : enc->shield[index];
+        SetEnemyShield(state, index, enc->shield[index] - damage_blocked);
+        PushEvent(state, COMBAT_EVENT_ENEMY_SHIELD_HIT, source, index, damage_blocked);
+    }
+    damage_dealt = damage - damage_blocked;
+
+    if (damage_dealt > 0) {
+        SetEnemyHealth(state, index, enc->health[index] - damage_dealt);
+        PushEvent(state, COMBAT_EVENT_ENEMY_DAMAGED, source, index, damage_dealt);
+    }
+    else if (report_block) {
+        PushEvent(state, COMBAT_EVENT_ENEMY_BLOCKED, source, index, 0);
+    }
+    if (enc->health[index] <= 0) KillEnemy(state, index);
+    return damage_dealt;
+}
+
+// Applies the same damage to every living enemy with the vector kernel, then reports it.
+// Returns the total health damage dealt.
+static int DamageAllEnemies(CombatState* state, int damage, CombatSource source) {
+    Encounter* enc = state->encounter;
+    if (!enc) return 0;
+    int32_t blocked[ENCOUNTER_MAX_ENEMIES];
+    int32_t dealt[ENCOUNTER_MAX_ENEMIES];
+    int32_t was_alive[ENCOUNTER_MAX_ENEMIES];
+    for (int i = 0; i < enc->enemy_count; i++) was_alive[i] = enc->alive[i];
+
+    int total = ApplyAoeDamage(enc->health, enc->shield, enc->alive, enc->enemy_count, damage, blocked, dealt);
+
+    // Events and hash updates in enemy order, same as resolving each enemy in turn
+    for (int i = 0; i < enc->enemy_count; i++) {
+        if (!was_alive[i]) continue;
+        if (blocked[i] > 0) {
+            Zobrist_Update(&state->hash, ZOBRIST_ENEMY_SHIELD, i, enc->shield[i] + blocked[i], enc->shield[i]);
+            PushEvent(state, COMBAT_EVENT_ENEMY_SHIELD_HIT, source, i, blocked[i]);
+        }
+        if (dealt[i] > 0) {
+            Zobrist_Update(&state->hash, ZOBRIST_ENEMY_HEALTH, i, enc->health[i] + dealt[i], enc->health[i]);
+            PushEvent(state, COMBAT_EVENT_ENEMY_DAMAGED, source, i, dealt[i]);
+        }
+        if (!enc->alive[i]) Zobrist_Update(&state->hash, ZOBRIST_ENEMY_ALIVE, i, 1, 0);
+    }
+    return total;
+}
+
+// Heals the player up to max health and reports the requested amount.
+static void HealPlayer(CombatState* state, int amount, CombatSource source) {
+    Player* p = state->player;
+    int health = p->health + amount;
+    if (health > p->max_health) health = p->max_health;
+    SetPlayerHealth(state, health);
+    PushEvent(state, COMBAT_EVENT_PLAYER_HEALED, source, -1, amount);
+}
+
+void Combat_Init(CombatState* state, Player* player, Encounter* encounter) {
+    if (!state) return;
+    state->player = player;
+    state->encounter = encounter;
+    state->hash = Zobrist_HashCombat(player, encounter);
+    state->bus = NULL;
+}
+
+void Combat_Bind(CombatState* state, Player* player, Encounter* encounter, uint64_t hash) {
+    if (!state) return;
+    state->player = player;
+    state->encounter = encounter;
+    state->hash = hash;
+    state->bus = NULL;
+}
+
+void Combat_Rehash(CombatState* state) {
+    if (!state) return;
+    state->hash = Zobrist_HashCombat(state->player, state->encounter);
+}
+
+bool Combat_CanPlayCard(const CombatState* state, CardType type, CardEffect effect, int target) {
+    (void)effect; // CLEAVE still needs a living target to aim at, same as a normal attack
+    if (!state || !state->player) return false;
+    if (type == Heal || type == Shield) return true;
+
+    const Encounter* enc = state->encounter;
+    return enc && target >= 0 && target < enc->enemy_count && enc->alive[target];
+}
+
+bool Combat_ApplyCard(CombatState* state, CardType type, CardEffect effect, int power, int target) {
+    if (!Combat_CanPlayCard(state, type, effect, target)) return false;
+
+    Player* player = state->player;
+
+    // --- ATTACK LOGIC ---
+    if (type == Attack) {
+        int damage_to_deal = power + player->attack_bonus;
+        if (player->has_attack_boost_35) {
+            damage_to_deal = (int)(damage_to_deal * 1.35f);
+        }
+
+        // Special Effect: CLEAVE (AOE) with 10% lifesteal on the total
+        if (effect == CLEAVE) {
+            if (damage_to_deal <= 0) damage_to_deal = 1;
+            int total_damage = DamageAllEnemies(state, damage_to_deal, COMBAT_SOURCE_CLEAVE);
+            if (total_damage > 0) {
+                int lifesteal_amount = (int)(total_damage * 0.10f);
+                if (lifesteal_amount < 1) lifesteal_amount = 1;
+                HealPlayer(state, lifesteal_amount, COMBAT_SOURCE_CLEAVE_LIFESTEAL);
+            }
+        }
+        // Normal Single Target Attack with 50% lifesteal if the buff is active
+        else {
+            int damage_dealt = DamageEnemy(state, target, damage_to_deal, COMBAT_SOURCE_ATTACK, true);
+            if (damage_dealt > 0 && player->has_lifesteal) {
+                int lifesteal_amount = (int)(damage_dealt * 0.50f);
+                if (lifesteal_amount < 1) lifesteal_amount = 1;
+                HealPlayer(state, lifesteal_amount, COMBAT_SOURCE_LIFESTEAL);
+            }
+        }
+    }
+    // --- HEAL LOGIC ---
+    else if (type == Heal) {
+        int heal_amount = power + player->heal_bonus;
+        if (player->has_heal_boost_35) {
+            heal_amount = (int)(heal_amount * 1.35f);
+        }
+        HealPlayer(state, heal_amount, COMBAT_SOURCE_HEAL);
+
+        // Special Effect: DIVINE STRIKE (Heal damages all enemies for half)
+        if (player->has_divine_strike || effect == DIVINE_STRIKE_EFFECT) {
+            int divine_damage = heal_amount / 2;
+            if (divine_damage < 1 && heal_amount > 0) divine_damage = 1;
+            if (divine_damage > 0 && state->encounter) {
+                DamageAllEnemies(state, divine_damage, COMBAT_SOURCE_DIVINE_STRIKE);
+            }
+        }
+    }
+    // --- SHIELD LOGIC ---
+    else if (type == Shield) {
+        int shield_amount = power + player->shield_bonus;
+        if (player->has_shield_boost) {
+            shield_amount = (int)(shield_amount * 1.25f);
+        }
+        if (player->has_shield_boost_35) {
+            shield_amount = (int)(shield_amount * 1.35f);
+        }
+        SetPlayerShield(state, player->shield + shield_amount);
+        PushEvent(state, COMBAT_EVENT_PLAYER_SHIELD_GAINED, COMBAT_SOURCE_SHIELD, -1, shield_amount);
+
+        // Special Effect: SHIELD BASH (deal 75% of current shield to all enemies)
+        if (effect == SHIELD_BASH) {
+            int damage_to_deal = (int)(player->shield * 0.75f);
+            if (damage_to_deal <= 0 && player->shield > 0) damage_to_deal = 1;
+            DamageAllEnemies(state, damage_to_deal, COMBAT_SOURCE_SHIELD_BASH);
+        }
+    }
+    return true;
+}
+
+void Combat_EnemyAttack(CombatState* state, int enemy_index) {
+    if (!state || !state->encounter || enemy_index < 0 || enemy_index >= state->encounter->enemy_count) return;
+    if (!state->encounter->alive[enemy_index]) return;
+
+    Player* player = state->player;
+    int damage_to_deal = state->encounter->attack[enemy_index];
+    int damage_blocked = 0;
+    int damage_dealt = 0;
+
+    // Apply Shield Mitigation
+    if (player->shield > 0) {
+        damage_blocked = (damage_to_deal <= player->shield) ? damage_to_deal : player->shield;
+        SetPlayerShield(state, player->shield - damage_blocked);
+        PushEvent(state, COMBAT_EVENT_PLAYER_SHIELD_HIT, COMBAT_SOURCE_ENEMY, enemy_index, damage_blocked);
+    }
+    damage_dealt = damage_to_deal - damage_blocked;
+
+    // Apply Damage to Health
+    if (damage_dealt > 0) {
+        SetPlayerHealth(state, player->health - damage_dealt);
+        PushEvent(state, COMBAT_EVENT_PLAYER_DAMAGED, COMBAT_SOURCE_ENEMY, enemy_index, damage_dealt);
+    }
+    else {
+        PushEvent(state, COMBAT_EVENT_PLAYER_BLOCKED, COMBAT_SOURCE_ENEMY, enemy_index, 0);
+    }
+}
+
+void Combat_EndEnemyTurn(CombatState* state) {
+    if (!state || !state->encounter) return;
+
+    // Enrage Mechanic (Bosses gain ATK every turn)
+    Encounter* enc = state->encounter;
+    for (int i = 0; i < enc->enemy_count; i++) {
+        const Enemy* e = enc->templates[i];
+        if (enc->alive[i] && e->enrages) {
+            SetEnemyAttack(state, i, enc->attack[i] + e->enrage_amount);
+            PushEvent(state, COMBAT_EVENT_ENEMY_ENRAGED, COMBAT_SOURCE_ENRAGE, i, e->enrage_amount);
+        }
+    }
+}
+
+void Combat_RunEnemyTurn(CombatState* state) {
+    if (!state || !state->encounter) return;
+    for (int i = 0; i < state->encounter->enemy_count; i++) {
+        Combat_EnemyAttack(state, i);
+    }
+    Combat_EndEnemyTurn(state);
+}
+
+bool Combat_AllEnemiesDefeated(const CombatState* state) {
+    if (!state || !state->encounter || state->encounter->enemy_count <= 0) return false;
+    const Encounter* enc = state->encounter;
+    for (int i = 0; i < enc->enemy_count; i++) {
+        if (enc->alive[i] && enc->health[i] > 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int Combat_LivingEnemyCount(const CombatState* state) {
+    int count = 0;
+    if (!state || !state->encounter) return 0;
+    for (int i = 0; i < state->encounter->enemy_count; i++) {
+        if (state->encounter->alive[i]) count++;
+    }
+    return count;
+}
+
+void Combat_SetEventBus(CombatState* state, EventBus* bus) {
+    if (!state) return;
+    state->bus = bus;
+}
@@ -0,0 +1,88 @@
+// Headless combat rules: card resolution, shield mitigation and enemy attacks.
+// Nothing in here draws or plays sounds; every visible outcome is reported as a CombatEvent on the
+// state's event bus (eventbus.h), if one is attached.
+#pragma once
+#include <stdbool.h>
+#include <stdint.h>
+#include "player.h"
+#include "levels.h"
+#include "carddef.h"
+
+typedef struct EventBus EventBus;
+
+// What happened during a rules step.
+typedef enum {
+    COMBAT_EVENT_ENEMY_SHIELD_HIT,    // Enemy shield absorbed part of a hit
+    COMBAT_EVENT_ENEMY_DAMAGED,       // Enemy lost health
+    COMBAT_EVENT_ENEMY_BLOCKED,       // Single-target hit fully absorbed by the enemy shield
+    COMBAT_EVENT_PLAYER_HEALED,       // Player regained health
+    COMBAT_EVENT_PLAYER_SHIELD_GAINED,
+    COMBAT_EVENT_PLAYER_SHIELD_HIT,   // Player shield absorbed part of an enemy attack
+    COMBAT_EVENT_PLAYER_DAMAGED,
+    COMBAT_EVENT_PLAYER_BLOCKED,      // Enemy attack fully absorbed by the player shield
+    COMBAT_EVENT_ENEMY_ENRAGED        // Enemy gained attack at the end of the enemy turn
+} CombatEventType;
+
+// What caused the event, so the presentation can pick colors, sounds and particles.
+typedef enum {
+    COMBAT_SOURCE_ATTACK,
+    COMBAT_SOURCE_CLEAVE,
+    COMBAT_SOURCE_DIVINE_STRIKE,
+    COMBAT_SOURCE_SHIELD_BASH,
+    COMBAT_SOURCE_HEAL,
+    COMBAT_SOURCE_SHIELD,
+    COMBAT_SOURCE_LIFESTEAL,        // 50% single-target lifesteal buff
+    COMBAT_SOURCE_CLEAVE_LIFESTEAL, // 10% lifesteal from AOE damage
+    COMBAT_SOURCE_ENEMY,
+    COMBAT_SOURCE_ENRAGE
+} CombatSource;
+
+typedef struct {
+    CombatEventType type;
+    CombatSource source;
+    int target; // Enemy index, or -1 when the player is the subject
+    int amount;
+} CombatEvent;
+
+// The state the rules operate on. The player and encounter are owned by the caller.
+typedef struct CombatState {
+    Player* player;
+    Encounter* encounter; // NULL between fights
+    uint64_t hash; // Zobrist hash of the player and enemies (zobrist.h), updated by every rule
+    EventBus* bus; // Receives the events; NULL (the default) skips building them at all
+} CombatState;
+
+// Binds the combat state to a player and an encounter and hashes them. Detaches any event bus.
+void Combat_Init(CombatState* state, Player* player, Encounter* encounter);
+
+// Like Combat_Init, but trusts a hash the caller already holds for exactly this state (O(1)).
+void Combat_Bind(CombatState* state, Player* player, Encounter* encounter, uint64_t hash);
+
+// Recomputes the hash after the player or enemies were changed outside the rules.
+void Combat_Rehash(CombatState* state);
+
+// Returns true if a card of this type/effect can be played against the enemy at index target.
+// Heal and Shield cards are always playable; attacks need a living target.
+bool Combat_CanPlayCard(const CombatState* state, CardType type, CardEffect effect, int target);
+
+// Resolves a card with the given base power against the enemy at index target.
+// Returns false (and changes nothing) if the card has no valid target.
+bool Combat_ApplyCard(CombatState* state, CardType type, CardEffect effect, int power, int target);
+
+// Resolves a single enemy's attack against the player. Dead enemies do nothing.
+void Combat_EnemyAttack(CombatState* state, int enemy_index);
+
+// Applies end-of-enemy-turn effects (enrage).
+void Combat_EndEnemyTurn(CombatState* state);
+
+// Runs a whole enemy turn at once: every living enemy attacks, then end-of-turn effects apply.
+void Combat_RunEnemyTurn(CombatState* state);
+
+// Returns true if every enemy is dead.
+bool Combat_AllEnemiesDefeated(const CombatState* state);
+
+// Returns the number of living enemies.
+int Combat_LivingEnemyCount(const CombatState* state);
+
+// Attaches the bus that receives every event from now on (NULL to stop reporting).
+void Combat_SetEventBus(CombatState* state, EventBus* bus);
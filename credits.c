@@ -2,6 +2,8 @@
 #include <stdio.h>
 #include <string.h>
 #include "mainmenu.h"
+#include "assets.h"
+#include "trace.h"
 
 // ------ Constants For Credits ------
 #define HOLD_TIME           1.5
@@ -49,6 +51,7 @@ typedef struct {
 
 // ------ Variables ------
 CP_Font credit_font = NULL; 
+static AssetId credit_font_id = ASSET_NONE;
 SlideIndex current_slide;
 CreditBlock text[TEXTBLOCK_COUNT]; // to hold textblock structs
 CreditFadeState fade_state;
@@ -64,7 +67,7 @@ void LoadCredit(const char* filename) {
     FILE* fcredits = fopen(filename, "r");
     if (!fcredits) {
         // if we cannot load file we push notification to read that file loading unsucessful
-        strcpy_s(text[0].lines[0], sizeof(text[0].lines[0]), "Error loading Credits file");
+        snprintf(text[0].lines[0], sizeof(text[0].lines[0]), "%s", "Error loading Credits file");
         return;
     }
 
@@ -88,7 +91,7 @@ void LoadCredit(const char* filename) {
         }
         else if (line_count < MAX_LINE_PER_TEXTBLOCK) {
             // copy line into current textblock
-            strcpy_s(text[text_block].lines[line_count], sizeof(text[text_block].lines[line_count]), buffer);
+            snprintf(text[text_block].lines[line_count], sizeof(text[text_block].lines[line_count]), "%s", buffer);
             line_count++;
         }
     }
@@ -106,10 +109,10 @@ void LoadCredit(const char* filename) {
 // ------ INIT ------
 void Credits_Init(void)
 {
-    // load font if not loaded.
-    if (credit_font == NULL) {
-        credit_font = CP_Font_Load("Assets/Exo2-Regular.ttf");
-    }
+    Trace_AsyncBegin(TRACE_CAT_STATE, "Credits", TRACE_ID_SCREEN);
+    // load font (shared through the asset registry)
+    credit_font_id = Asset_Acquire(ASSET_FONT, "Assets/Exo2-Regular.ttf");
+    credit_font = Asset_Font(credit_font_id);
     current_slide = GAME_AND_TEAM_NAME; // set as 1st slide
     fade_state = FADE_IN; // set as 1st phase
     // init as 0 for fade in
@@ -345,6 +348,8 @@ void Credits_Update(void)
 // ------ EXIT ------
 void Credits_Exit(void)
 {
-    // free font used
-    CP_Font_Free(credit_font);
+    // release font used
+    Asset_Release(&credit_font_id);
+    credit_font = NULL;
+    Trace_AsyncEnd(TRACE_CAT_STATE, "Credits", TRACE_ID_SCREEN);
 }
\ No newline at end of file
@@ -5,23 +5,29 @@
 // Initializes the deck with a standard set of starting cards.
 void InitDeck(Deck* deck);
 
-// Adds a single card to the deck. Returns true if successful, or false if the deck is full.
-bool AddCardToDeck(Deck* deck, Card card);
+// Adds a new card to the player's cards and puts it at the bottom of the draw pile. Returns false if every slot is taken.
+bool AddCardToDeck(Deck* deck, CardId id);
 
-// Removes the card at the specified index from the deck and shifts remaining cards. Returns true if successful.
+// Removes the card at the specified draw pile position from the deck entirely, freeing its slot. Returns true if successful.
 bool RemoveCardFromDeck(Deck* deck, int index);
 
-// Retrieves a copy of the card at the specified index from the deck. Returns a dummy card if the index is invalid.
-Card GetDeckCard(Deck* deck, int index);
+// Takes the top card off the draw pile and returns its slot. Returns -1 if the draw pile is empty.
+int DrawFromDeck(Deck* deck);
 
-// Checks if the deck has reached its capacity. Returns true if full.
+// Puts a card dealt from this deck back at the bottom of the draw pile. Returns true if successful.
+bool ReturnCardToDeck(Deck* deck, const Card* card);
+
+// Returns the id of the card at the specified draw pile position, or CARD_ID_NONE if the index is invalid.
+CardId GetDeckCard(Deck* deck, int index);
+
+// Checks if every card slot is taken. Returns true if full.
 bool IsDeckFull(Deck* deck);
 
-// Checks if the deck has no cards. Returns true if empty.
+// Checks if the draw pile has no cards. Returns true if empty.
 bool IsDeckEmpty(Deck* deck);
 
-// Returns the current number of cards in the deck.
+// Returns the current number of cards in the draw pile.
 int GetDeckSize(Deck* deck);
 
-// Resets the deck size to zero, effectively clearing it.
+// Frees every slot and empties the draw pile.
 void ClearDeck(Deck* deck);
\ No newline at end of file
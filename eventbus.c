@@ -0,0 +1,37 @@
+// @file eventbus.c
+// @brief SPSC ring buffer over free-running 64-bit indices.
+//
+// head and tail only ever grow; slot = index & (capacity - 1). The producer writes the slot before
+// publishing the new tail, and the consumer reads the slot before publishing the new head, so each
+// side only ever sees fully written events. The platform atomics are sequentially consistent.
+
+#include "eventbus.h"
+#include <string.h>
+
+void EventBus_Init(EventBus* bus) {
+    memset(bus, 0, sizeof(*bus));
+    Platform_AtomicStore64(&bus->head, 0);
+    Platform_AtomicStore64(&bus->tail, 0);
+}
+
+bool EventBus_Push(EventBus* bus, const CombatEvent* ev) {
+    uint64_t tail = Platform_AtomicLoad64(&bus->tail); // Only this side writes it
+    if (tail - bus->cached_head >= EVENT_BUS_CAPACITY) {
+        bus->cached_head = Platform_AtomicLoad64(&bus->head);
+        if (tail - bus->cached_head >= EVENT_BUS_CAPACITY) {
+            bus->dropped++;
+            return false;
+        }
+    }
+    bus->events[tail & (EVENT_BUS_CAPACITY - 1)] = *ev;
+    Platform_AtomicStore64(&bus->tail, tail + 1);
+    return true;
+}
+
+bool EventBus_Pop(EventBus* bus, CombatEvent* out) {
+    uint64_t head = Platform_AtomicLoad64(&bus->head);
+    if (head == Platform_AtomicLoad64(&bus->tail)) return false;
+    *out = bus->events[head & (EVENT_BUS_CAPACITY - 1)];
+    Platform_AtomicStore64(&bus->head, head + 1);
+    return true;
+}
@@ -0,0 +1,29 @@
+// Lock-free single-producer / single-consumer ring of combat events. The rules push into it while
+// resolving, the game screen drains it once per frame to spawn numbers, flashes, particles and sounds.
+// Producer and consumer may run on different threads. Render-free.
+#pragma once
+#include <stdbool.h>
+#include <stdint.h>
+#include "combat.h"
+#include "platform.h"
+
+#define EVENT_BUS_CAPACITY 256 // Power of two; far more than one frame of combat produces
+
+struct EventBus {
+    PlatformAtomic64 head;      // Next event to read; written by the consumer only
+    char head_padding[64 - sizeof(PlatformAtomic64)]; // Keep the two ends on separate cache lines
+    PlatformAtomic64 tail;      // Next free slot; written by the producer only
+    uint64_t cached_head;       // Producer's last look at head, so most pushes don't touch the consumer's line
+    uint64_t dropped;           // Events pushed while the ring was full
+    char tail_padding[64 - sizeof(PlatformAtomic64) - 2 * sizeof(uint64_t)];
+    CombatEvent events[EVENT_BUS_CAPACITY];
+};
+
+// Empties the ring. Neither side may be using it.
+void EventBus_Init(EventBus* bus);
+
+// Producer side: appends an event. Returns false (and counts it as dropped) if the ring is full.
+bool EventBus_Push(EventBus* bus, const CombatEvent* ev);
+
+// Consumer side: takes the oldest event. Returns false if there is none.
+bool EventBus_Pop(EventBus* bus, CombatEvent* out);
@@ -7,6 +7,7 @@
 #include "utils.h"
 #include <stdbool.h>
 #include "card.h"
+#include "deck.h"
 #include "levels.h"
 #include <stdio.h>
 #include "game.h"
@@ -16,20 +17,18 @@
 #include "victory.h" 
 #include <string.h> 
 #include "sfx.h"
-
-// ---------------------------------------------------------
-// 0. EXTERN DECLARATIONS (Safety Net)
-// ---------------------------------------------------------
-// Importing enemy data defined in levels.c
-extern Enemy level1_enemies[]; extern int level1_enemy_count;
-extern Enemy level2_enemies[]; extern int level2_enemy_count;
-extern Enemy level3_enemies[]; extern int level3_enemy_count;
-extern Enemy level4_enemies[]; extern int level4_enemy_count;
-extern Enemy level5_enemies[]; extern int level5_enemy_count;
-extern Enemy level6_enemies[]; extern int level6_enemy_count;
-extern Enemy level7_enemies[]; extern int level7_enemy_count;
-extern Enemy level8_enemies[]; extern int level8_enemy_count;
-extern Enemy level9_enemies[]; extern int level9_enemy_count;
+#include "combat.h"
+#include "progression.h"
+#include "ai.h"
+#include "replay.h"
+#include "timestep.h"
+#include "eventbus.h"
+#include "sprite.h"
+#include "text.h"
+#include "assets.h"
+#include "trace.h"
+#include "profiler.h"
+#include "zobrist.h"
 
 // ---------------------------------------------------------
 // 1. GLOBAL VARIABLES
@@ -43,6 +42,11 @@ int selected_card_index; // Index of the currently highlighted card in the hand
 
 #define CARD_SCALE 1.5f
 
+// Enemy layout on screen (see EnemyScreenPos)
+#define ENEMY_W 120.0f
+#define ENEMY_H 160.0f
+#define ENEMY_SPACING 40.0f
+
 // Screen positions for the draw and discard piles
 CP_Vector deck_pos;
 CP_Vector discard_pos;
@@ -58,6 +62,7 @@ Card hand[MAX_HAND_SIZE];
 Card discard[MAX_DECK_SIZE];
 int discard_size;
 int hand_size;
+static uint64_t hand_hash; // Sum of CardHashKey over the hand cards that aren't discarding
 int recycling_count;
 bool is_recycling; // Flag for the deck shuffling animation
 
@@ -69,14 +74,25 @@ BuffRewardState buff_reward_state;
 // Flag to handle respawning at a checkpoint (set by GameOver screen)
 static bool g_is_restarting_from_checkpoint = false;
 
-// --- Player/Game State ---
-#define START_ATTACK 7
-#define START_SHIELD 0 
-#define START_HEALTH 80
-#define INITIAL_DECK_SIZE 14
+// Random streams for the current run, all derived from its seed (see rng.h)
+static uint64_t session_seed;
+static uint64_t runs_started;
+static Rng game_rng[RNG_STREAM_COUNT];
+
+// Replay log of the current run, saved to replay_path (if set) whenever the game screen exits
+static ReplayLog replay_log;
+static const char* replay_path = NULL;
+static int replay_card = -1;   // Last card selection written to the log
+static int replay_target = -1; // Last target written to the log
+
+// Logic runs in fixed ticks (timestep.h); frames render between the last two
+static Timestep game_clock;
+static bool instant_mode = false;
 
+// --- Player/Game State ---
+// Starting stats live in progression.h so the run simulator uses the same numbers
 static Player player = {
-    START_HEALTH, START_HEALTH, START_ATTACK, START_SHIELD,
+    PLAYER_START_HEALTH, PLAYER_START_HEALTH, PLAYER_START_ATTACK, PLAYER_START_SHIELD,
     false, false, false, false, // Initial Buff flags (all false)
     false, false, false,        // Tier 2 Buff flags
     1,                          // Checkpoint Level
@@ -86,11 +102,47 @@ static Player player = {
 
 static int selected_enemy = 0; // Index of the currently targeted enemy
 
-// Current level data pointers
-static Enemy* current_enemies = NULL;
+// Current level data: enemies are this screen's own copies, the level templates stay untouched
+static Encounter encounter;
+static Encounter* current_enemies = NULL; // &encounter while a level is loaded
 static int current_enemy_count = 0;
 static int current_level = 1;
 
+// Headless rules state bound to the player and the current enemies
+static CombatState combat;
+static EventBus combat_events; // The rules push, PresentCombatEvents drains once per frame
+
+// Sections of Game_Update timed by the profiler, in the order the frame runs them
+typedef enum {
+    SECTION_TICKS,
+    SECTION_BACKGROUND,
+    SECTION_STATE_CHECKS,
+    SECTION_PHASE,
+    SECTION_ENTITIES,
+    SECTION_HUD,
+    SECTION_CARD_CLEANUP,
+    SECTION_PILES,
+    SECTION_DEAL,
+    SECTION_HAND,
+    SECTION_ACTION_BUTTON,
+    SECTION_INPUT,
+    SECTION_CARD_EFFECTS,
+    SECTION_DEVELOPER,
+    SECTION_RECYCLING,
+    SECTION_PROFILER,
+    SECTION_COUNT
+} GameSection;
+
+static const char* const section_names[SECTION_COUNT] = {
+    "Logic ticks", "Background", "State checks", "Phase logic", "Player & enemies", "HUD",
+    "Card cleanup", "Piles", "Deal", "Hand", "Action button", "Input", "Card effects",
+    "Developer", "Recycling", "Profiler overlay"
+};
+
+// Turn solver behind the hint key, created on first use
+static AiSearch* hint_search = NULL;
+#define HINT_MAX_SECONDS 0.05
+
 // UI/Flow Flags
 static bool stage_cleared = false;
 static float banner_timer = 0.0f;
@@ -105,19 +157,6 @@ static float enemy_hit_flash[16] = { 0.0f };
 static float enemy_shield_flash[16] = { 0.0f };
 static float enemy_slash_timer[16] = { 0.0f }; // Timer for the red slash effect
 
-// --- ASSETS & SPRITES ---
-static CP_Image img_player = NULL;
-static CP_Image img_goblin = NULL;
-static CP_Image img_slime = NULL;
-static CP_Image img_witch = NULL;
-static CP_Image img_orc = NULL;
-static CP_Image img_ogre = NULL;
-static CP_Image img_shadow = NULL;
-static CP_Image img_lich = NULL;
-
-static CP_Image img_heart_particle = NULL;
-static CP_Image img_shield_particle = NULL;
-
 // Floating Text System (Damage Numbers)
 static FloatingText floating_texts[MAX_FLOATING_TEXTS];
 static int floating_text_count = 0;
@@ -128,23 +167,25 @@ typedef struct {
     CP_Vector pos;
     float timer;
     float max_time;
-    CP_Image img;
+    SpriteId sprite;
     float scale;
 } FloatingIcon;
 
 static FloatingIcon floating_icons[MAX_FLOATING_ICONS];
 static int floating_icon_count = 0;
 
+// Asset handles (assets.h) and what they resolve to, held between Game_Init and Game_Exit.
+// The sound effects live in sfx.c.
+#define GAME_FONT_PATH "Assets/Exo2-Regular.ttf"
+#define GAME_BG_PATH "Assets/background.png"
+#define GAME_MUSIC_PATH "Assets/background_music.wav"
+static AssetId game_font_id = ASSET_NONE;
+static AssetId game_bg_id = ASSET_NONE;
+static AssetId background_music_id = ASSET_NONE;
 static CP_Font game_font;
 static CP_Image game_bg = NULL;
-
 static CP_Sound background_music = NULL;
 
-// --- SFX ASSETS ---
-static CP_Sound sfx_shield = NULL;
-static CP_Sound sfx_heal = NULL;
-static CP_Sound sfx_draw = NULL;
-
 // Battle Phase State Machine
 typedef enum {
     PHASE_PLAYER, // Player's turn to play cards
@@ -157,6 +198,7 @@ BattlePhase current_phase = PHASE_PLAYER;
 float enemy_turn_timer = 0.0f;
 int enemy_action_index = 0;      // Which enemy is currently acting
 float enemy_anim_offset_x = 0.0f; // For the "lunging" animation
+static float enemy_anim_prev_x = 0.0f; // Lunge offset at the previous logic tick, for interpolation
 bool enemy_has_hit = false;      // To ensure damage is applied only once per lunge
 
 
@@ -179,22 +221,45 @@ int Game_Get_Death_Count(void) {
     return player.death_count;
 }
 
+void Game_SetSeed(uint64_t seed) {
+    session_seed = seed;
+    runs_started = 0;
+}
+
+void Game_SetReplayPath(const char* path) {
+    replay_path = path;
+}
+
+void Game_SetInstant(bool instant) {
+    instant_mode = instant;
+}
+
+// Seeds every stream for a fresh run and prints the seed so the run can be replayed with --seed.
+static void StartRunStreams(void) {
+    uint64_t run_seed = (runs_started == 0) ? session_seed : Rng_SeedFor(session_seed, runs_started);
+    runs_started++;
+    for (int s = 0; s < RNG_STREAM_COUNT; s++) Rng_Init(&game_rng[s], run_seed, (RngStream)s);
+    printf("Run seed: %llu\n", (unsigned long long)run_seed);
+    Replay_Begin(&replay_log, run_seed);
+    replay_card = -1;
+    replay_target = -1;
+}
+
 // Spawns a visual particle icon at a specific location.
-static void SpawnFloatingIcon(CP_Image img, CP_Vector pos, float scale) {
+static void SpawnFloatingIcon(SpriteId sprite, CP_Vector pos, float scale) {
     if (floating_icon_count >= MAX_FLOATING_ICONS) return;
 
     FloatingIcon* icon = &floating_icons[floating_icon_count];
     icon->pos = pos;
-    icon->img = img;
+    icon->sprite = sprite;
     icon->scale = scale;
     icon->max_time = 1.5f;
     icon->timer = icon->max_time;
     floating_icon_count++;
 }
 
-// Updates physics and rendering for all active floating icons (particles).
-static void UpdateAndDrawFloatingIcons(void) {
-    float dt = CP_System_GetDt();
+// Advances all active floating icons (particles) by one logic tick.
+static void UpdateFloatingIcons(float dt) {
     for (int i = 0; i < floating_icon_count; i++) {
         FloatingIcon* icon = &floating_icons[i];
         icon->timer -= dt;
@@ -209,19 +274,26 @@ static void UpdateAndDrawFloatingIcons(void) {
 
         // Float upwards
         icon->pos.y -= 30.0f * dt;
+    }
+}
+
+// Renders all active floating icons in one sprite batch. They drift too slowly to need interpolation.
+static void DrawFloatingIcons(void) {
+    Sprite_BeginBatch();
+    for (int i = 0; i < floating_icon_count; i++) {
+        const FloatingIcon* icon = &floating_icons[i];
 
         // Fade out
         float alpha_ratio = icon->timer / icon->max_time;
         int alpha = (int)(255.0f * alpha_ratio);
         if (alpha < 0) alpha = 0;
 
-        if (icon->img) {
-            CP_Image_Draw(icon->img, icon->pos.x, icon->pos.y,
-                CP_Image_GetWidth(icon->img) * icon->scale,
-                CP_Image_GetHeight(icon->img) * icon->scale,
-                alpha);
-        }
+        Sprite_Draw(icon->sprite, icon->pos.x, icon->pos.y,
+            Sprite_Width(icon->sprite) * icon->scale,
+            Sprite_Height(icon->sprite) * icon->scale,
+            alpha);
     }
+    Sprite_Flush();
 }
 
 // Spawns a floating damage number or text message.
@@ -235,12 +307,8 @@ static void SpawnFloatingText(const char* text, CP_Vector pos, CP_Color color) {
     floating_text_count++;
 }
 
-// Updates physics and rendering for floating text.
-static void UpdateAndDrawFloatingText(void) {
-    float dt = CP_System_GetDt();
-    CP_Settings_TextSize(32);
-    CP_Settings_TextAlignment(CP_TEXT_ALIGN_H_CENTER, CP_TEXT_ALIGN_V_MIDDLE);
-    CP_Font_Set(game_font);
+// Advances floating text by one logic tick.
+static void UpdateFloatingText(float dt) {
     for (int i = 0; i < floating_text_count; i++) {
         FloatingText* ft = &floating_texts[i];
         ft->timer -= dt;
@@ -251,22 +319,105 @@ static void UpdateAndDrawFloatingText(void) {
             continue;
         }
         ft->pos.y -= 20.0f * dt;
-        CP_Color color = ft->color;
-        color.a = (int)(255.0f * ft->timer); // Fade alpha
-        CP_Settings_Fill(color);
-        CP_Font_DrawText(ft->text, ft->pos.x, ft->pos.y);
     }
 }
 
-// Checks if all enemies in the current level are dead.
-static bool AllEnemiesDefeated(void) {
-    if (!current_enemies) return false;
-    for (int i = 0; i < current_enemy_count; i++) {
-        if (current_enemies[i].alive && current_enemies[i].health > 0) {
-            return false;
+// Renders floating text.
+static void DrawFloatingText(void) {
+    TextStyle style = { game_font, 32.0f, CP_TEXT_ALIGN_H_CENTER, CP_TEXT_ALIGN_V_MIDDLE, CP_Color_Create(255, 255, 255, 255) };
+    Text_Begin();
+    for (int i = 0; i < floating_text_count; i++) {
+        const FloatingText* ft = &floating_texts[i];
+        style.fill = ft->color;
+        style.fill.a = (int)(255.0f * ft->timer); // Fade alpha
+        Text_Draw(&style, ft->text, ft->pos.x, ft->pos.y);
+    }
+}
+
+// Returns the top-left screen position of the enemy at the given index. Rendering, clicks and effects
+// all place enemies through it.
+static CP_Vector EnemyScreenPos(int index) {
+    float ww = (float)CP_System_GetWindowWidth();
+    float wh = (float)CP_System_GetWindowHeight();
+    float start_x = ww - (float)current_enemy_count * ENEMY_W - 200.0f;
+    return CP_Vector_Set(start_x + (float)index * (ENEMY_W + ENEMY_SPACING), wh / 2.0f - ENEMY_H / 2.0f);
+}
+
+// Turns the events the combat rules pushed since the last frame into flashes, floating numbers,
+// particles and sounds.
+static void PresentCombatEvents(void) {
+    float wh = (float)CP_System_GetWindowHeight();
+    char text[16];
+
+    CombatEvent event;
+    while (EventBus_Pop(&combat_events, &event)) {
+        const CombatEvent* ev = &event;
+        CP_Vector enemy_pos = (ev->target >= 0) ? EnemyScreenPos(ev->target) : CP_Vector_Set(0.0f, 0.0f);
+
+        switch (ev->type) {
+        case COMBAT_EVENT_ENEMY_SHIELD_HIT:
+            enemy_shield_flash[ev->target] = 0.2f;
+            break;
+        case COMBAT_EVENT_ENEMY_DAMAGED:
+            enemy_hit_flash[ev->target] = 0.2f;
+            enemy_slash_timer[ev->target] = 0.3f;
+            snprintf(text, sizeof(text), "-%d", ev->amount);
+            if (ev->source == COMBAT_SOURCE_ATTACK) {
+                SpawnFloatingText(text, CP_Vector_Set(enemy_pos.x + 60.0f, enemy_pos.y), CP_Color_Create(255, 80, 80, 255));
+            }
+            else if (ev->source == COMBAT_SOURCE_DIVINE_STRIKE) {
+                SpawnFloatingText(text, CP_Vector_Set(enemy_pos.x + 60.0f, enemy_pos.y - 30.0f), CP_Color_Create(255, 255, 100, 255));
+            }
+            else {
+                // AOE numbers float a little higher so they don't overlap single-target hits
+                SpawnFloatingText(text, CP_Vector_Set(enemy_pos.x + 60.0f, enemy_pos.y - 30.0f), CP_Color_Create(255, 80, 80, 255));
+            }
+            break;
+        case COMBAT_EVENT_ENEMY_BLOCKED:
+            SpawnFloatingText("Block!", CP_Vector_Set(enemy_pos.x + 60.0f, enemy_pos.y), CP_Color_Create(150, 150, 255, 255));
+            break;
+        case COMBAT_EVENT_ENEMY_ENRAGED:
+            snprintf(text, sizeof(text), "ATK +%d", ev->amount);
+            SpawnFloatingText(text, CP_Vector_Set(enemy_pos.x + 60.0f, enemy_pos.y), CP_Color_Create(255, 100, 100, 255));
+            break;
+        case COMBAT_EVENT_PLAYER_HEALED:
+            snprintf(text, sizeof(text), "+%d", ev->amount);
+            if (ev->source == COMBAT_SOURCE_HEAL) {
+                Audio_Play(SFX_HEAL);
+                SpawnFloatingText(text, CP_Vector_Set(175.0f, wh / 2.0f), CP_Color_Create(80, 255, 80, 255));
+                // Particle effects
+                for (int h = 0; h < 3; h++) {
+                    float offsetX = (float)(h * 30 - 30);
+                    float offsetY = (float)(h % 2 == 0 ? 0 : 15);
+                    SpawnFloatingIcon(SPRITE_ICON_HEART, CP_Vector_Set(175.0f + offsetX, wh / 2.0f + offsetY), 0.3f);
+                }
+            }
+            else {
+                // Lifesteal: the single-target buff plays the heal sound, AOE lifesteal stays quiet
+                if (ev->source == COMBAT_SOURCE_LIFESTEAL) Audio_Play(SFX_HEAL);
+                SpawnFloatingText(text, CP_Vector_Set(175.0f, wh / 2.0f - 30.0f), CP_Color_Create(80, 255, 80, 255));
+            }
+            break;
+        case COMBAT_EVENT_PLAYER_SHIELD_GAINED:
+            player_shield_flash = 0.2f;
+            Audio_Play(SFX_SHIELD);
+            snprintf(text, sizeof(text), "+%d", ev->amount);
+            SpawnFloatingText(text, CP_Vector_Set(175.0f, wh / 2.0f), CP_Color_Create(80, 80, 255, 255));
+            SpawnFloatingIcon(SPRITE_ICON_SHIELD, CP_Vector_Set(175.0f, wh / 2.0f), 0.4f);
+            break;
+        case COMBAT_EVENT_PLAYER_SHIELD_HIT:
+            player_shield_flash = 0.2f;
+            break;
+        case COMBAT_EVENT_PLAYER_DAMAGED:
+            player_hit_flash = 0.2f;
+            snprintf(text, sizeof(text), "-%d", ev->amount);
+            SpawnFloatingText(text, CP_Vector_Set(175.0f, wh / 2.0f), CP_Color_Create(255, 80, 80, 255));
+            break;
+        case COMBAT_EVENT_PLAYER_BLOCKED:
+            SpawnFloatingText("Block!", CP_Vector_Set(175.0f, wh / 2.0f), CP_Color_Create(150, 150, 255, 255));
+            break;
         }
     }
-    return true;
 }
 
 // Draws the banner text when a stage is cleared.
@@ -295,33 +446,16 @@ void ResetStageState(void) {
     banner_timer = 0.0f;
     current_phase = PHASE_PLAYER;
     enemy_anim_offset_x = 0.0f;
+    enemy_anim_prev_x = 0.0f;
     enemy_has_hit = false;
-    player.shield = START_SHIELD; // Reset shield at start of new combat
+    player.shield = PLAYER_START_SHIELD; // Reset shield at start of new combat
     ResetReward(&reward_state);
     ResetBuffReward(&buff_reward_state);
 }
 
 // Completely resets the game to a fresh start state.
 void ResetGame(void) {
-    player.health = START_HEALTH;
-    player.max_health = START_HEALTH;
-    player.attack = START_ATTACK;
-    player.shield = START_SHIELD;
-    // Reset all buffs
-    player.has_lifesteal = false;
-    player.has_desperate_draw = false;
-    player.has_divine_strike = false;
-    player.has_shield_boost = false;
-    player.has_attack_boost_35 = false;
-    player.has_heal_boost_35 = false;
-    player.has_shield_boost_35 = false;
-
-    player.checkpoint_level = 1;
-    player.death_count = 0;
-    player.attack_bonus = 0;
-    player.heal_bonus = 0;
-    player.shield_bonus = 0;
-    player.card_reward_count = 0;
+    Progression_ResetPlayer(&player);
 
     selected_card_index = -1;
     played_cards = 0;
@@ -331,16 +465,20 @@ void ResetGame(void) {
     current_enemy_count = 0;
     current_enemies = NULL;
     ResetStageState();
+    Combat_Init(&combat, &player, NULL);
+    Combat_SetEventBus(&combat, &combat_events);
 }
 
 // Loads specific enemy data for the requested level and resets the deck if needed.
 void LoadLevel(int level) {
     // If we pass the max level, go to Victory screen
-    if (level > MAX_LEVEL) {
+    if (level > MAX_LEVEL || !Levels_Get(level)) {
+        Replay_Record(&replay_log, REPLAY_WIN, 0, 0, 0);
         CP_Engine_SetNextGameState(Victory_Init, Victory_Update, Victory_Exit);
         return;
     }
 
+    Replay_Record(&replay_log, REPLAY_LEVEL, level, 0, 0);
     player.checkpoint_level = level;
     current_enemies = NULL;
     current_enemy_count = 0;
@@ -353,83 +491,22 @@ void LoadLevel(int level) {
             discard_size++;
         }
         hand_size = 0;
-        // Position cards visually in the deck pile
-        CP_Vector deck_pos_center = CP_Vector_Set(
-            deck_pos.x + (CARD_W_INIT * CARD_SCALE) / 2.0f,
-            deck_pos.y + (CARD_H_INIT * CARD_SCALE) / 2.0f
-        );
-        for (int i = 0; i < discard_size; i++) {
-            player_deck.cards[player_deck.size] = discard[i];
-            player_deck.cards[player_deck.size].pos = deck_pos_center;
-            player_deck.size++;
-        }
-        discard_size = 0;
-        ShuffleDeck(&player_deck);
+        hand_hash = 0;
+        RecycleDeck(discard, &player_deck, &discard_size, &game_rng[RNG_STREAM_SHUFFLE]);
     }
 
     dealt = false;
     turn_num = 0;
     played_cards = 0;
 
-    // Select enemy set based on level
-    if (level == 1) {
-        current_enemies = level1_enemies;
-        current_enemy_count = level1_enemy_count;
-    }
-    else if (level == 2) {
-        current_enemies = level2_enemies;
-        current_enemy_count = level2_enemy_count;
-    }
-    else if (level == 3) {
-        current_enemies = level3_enemies;
-        current_enemy_count = level3_enemy_count;
-    }
-    else if (level == 4) {
-        current_enemies = level4_enemies;
-        current_enemy_count = level4_enemy_count;
-    }
-    else if (level == 5) {
-        current_enemies = level5_enemies;
-        current_enemy_count = level5_enemy_count;
-    }
-    else if (level == 6) {
-        current_enemies = level6_enemies;
-        current_enemy_count = level6_enemy_count;
-    }
-    else if (level == 7) {
-        current_enemies = level7_enemies;
-        current_enemy_count = level7_enemy_count;
-    }
-    else if (level == 8) {
-        current_enemies = level8_enemies;
-        current_enemy_count = level8_enemy_count;
-    }
-    else if (level == 9) {
-        current_enemies = level9_enemies;
-        current_enemy_count = level9_enemy_count;
-    }
-
-    // Fallback safety
-    if (current_enemies == NULL || current_enemy_count <= 0) {
-        current_enemies = level1_enemies;
-        current_enemy_count = level1_enemy_count;
-    }
-
-    // Reset enemy stats (hp, shield) for the new level
-    if (current_enemies && current_enemy_count > 0) {
-        for (int i = 0; i < current_enemy_count; i++) {
-            current_enemies[i].health = current_enemies[i].max_health;
-            current_enemies[i].shield = 0;
-            current_enemies[i].alive = true;
-            current_enemies[i].has_used_special = false;
-            // Reset enrage status if applicable
-            if (current_enemies[i].enrages) {
-                current_enemies[i].attack = current_enemies[i].max_attack;
-            }
-        }
-    }
+    // Copy the level's enemy templates into a fresh encounter (falls back to level 1)
+    Encounter_Load(&encounter, level);
+    current_enemies = &encounter;
+    current_enemy_count = encounter.enemy_count;
 
-    ResetStageState();
+    ResetStageState(); // Resets the player shield, so it runs before the rules hash the state
+    Combat_Init(&combat, &player, current_enemies);
+    Combat_SetEventBus(&combat, &combat_events);
 }
 
 // Logic for cycling through targetable enemies using Left/Right keys.
@@ -443,9 +520,9 @@ static void HandleEnemySelection(void) {
     bool found_new_target = false;
 
     // Ensure current selection is valid; if not, find the first alive enemy
-    if (original_selection < 0 || original_selection >= current_enemy_count || (current_enemies && !current_enemies[original_selection].alive)) {
+    if (original_selection < 0 || original_selection >= current_enemy_count || (current_enemies && !current_enemies->alive[original_selection])) {
         for (int i = 0; i < current_enemy_count; ++i) {
-            if (current_enemies[i].alive) {
+            if (current_enemies->alive[i]) {
                 selected_enemy = i;
                 found_new_target = true;
                 break;
@@ -463,7 +540,7 @@ static void HandleEnemySelection(void) {
         current_selection--;
         while (current_selection != original_selection) {
             if (current_selection < 0) current_selection = current_enemy_count - 1;
-            if (current_enemies[current_selection].alive) {
+            if (current_enemies->alive[current_selection]) {
                 selected_enemy = current_selection;
                 return;
             }
@@ -476,7 +553,7 @@ static void HandleEnemySelection(void) {
         current_selection++;
         while (current_selection != original_selection) {
             if (current_selection >= current_enemy_count) current_selection = 0;
-            if (current_enemies[current_selection].alive) {
+            if (current_enemies->alive[current_selection]) {
                 selected_enemy = current_selection;
                 return;
             }
@@ -489,25 +566,24 @@ static void HandleEnemySelection(void) {
 // Checks if stage is cleared and manages the Reward Screen transition.
 static int UpdateStageClear(void) {
     // Detect if all enemies died just now
-    if (!stage_cleared && !reward_active && !buff_reward_active && AllEnemiesDefeated() && current_enemy_count > 0) {
+    if (!stage_cleared && !reward_active && !buff_reward_active && Combat_AllEnemiesDefeated(&combat)) {
         stage_cleared = true;
         banner_timer = 2.0f;
     }
 
     if (stage_cleared) {
         if (banner_timer > 0.0f) {
-            // Show "Stage Cleared" banner for a few seconds
-            banner_timer -= CP_System_GetDt();
+            // Show "Stage Cleared" banner for a few seconds (counted down in TickAnimations)
             DrawStageClearBanner();
-            UpdateAndDrawFloatingText();
-            UpdateAndDrawFloatingIcons();
+            DrawFloatingText();
+            DrawFloatingIcons();
             return 1; // Block other updates
         }
         else {
             // After banner, trigger reward generation
             stage_cleared = false;
             // Boss Levels (3, 6, 9) get Buff Rewards
-            if (current_level == 3 || current_level == 6 || current_level == 9) {
+            if (Progression_IsBossLevel(current_level)) {
                 buff_reward_active = true;
                 GenerateBuffOptions(&buff_reward_state, current_level);
             }
@@ -525,6 +601,9 @@ static int UpdateStageClear(void) {
         UpdateReward(&reward_state, &player_deck, &player);
         DrawReward(&reward_state, &player);
         if (reward_state.reward_claimed) {
+            RewardType type = reward_state.options[reward_state.selected_index].type;
+            Replay_Record(&replay_log, REPLAY_REWARD,
+                (type == REWARD_ATTACK_CARD) ? Attack : (type == REWARD_HEAL_CARD) ? Heal : Shield, 0, 0);
             reward_active = false;
             LoadLevel(current_level + 1);
         }
@@ -536,6 +615,7 @@ static int UpdateStageClear(void) {
         UpdateBuffReward(&buff_reward_state, &player);
         DrawBuffReward(&buff_reward_state);
         if (buff_reward_state.reward_claimed) {
+            Replay_Record(&replay_log, REPLAY_BUFF, buff_reward_state.options[buff_reward_state.selected_index].type, 0, 0);
             buff_reward_active = false;
             LoadLevel(current_level + 1);
         }
@@ -544,28 +624,11 @@ static int UpdateStageClear(void) {
     return 0; // Normal game update can proceed
 }
 
-// General function to render a character (Player or Enemy) with health bars and status effects.
-static void DrawEntity(const char* name, int health, int max_health,
-    int attack, int shield, float x, float y, float w, float h,
-    CP_Color model_color, int is_selected, float hit_flash_timer, float shield_flash_timer, float slash_timer)
+// Draws a character's body (Player or Enemy): selection highlight, hit/shield flash and its sprite.
+// Call between Sprite_BeginBatch and Sprite_Flush so all bodies share one batch (sprites land after every highlight).
+static void DrawEntityBody(const char* name, float x, float y, float w, float h,
+    CP_Color model_color, int is_selected, float hit_flash_timer, float shield_flash_timer)
 {
-    // Lazy load sprites if needed
-    if (img_player == NULL) img_player = CP_Image_Load("Assets/player.png");
-    if (img_goblin == NULL) img_goblin = CP_Image_Load("Assets/goblin.png");
-    if (img_slime == NULL)  img_slime = CP_Image_Load("Assets/slime.png");
-    if (img_witch == NULL)  img_witch = CP_Image_Load("Assets/witch.png");
-    if (img_orc == NULL)    img_orc = CP_Image_Load("Assets/orc.png");
-    if (img_ogre == NULL)   img_ogre = CP_Image_Load("Assets/ogre.png");
-    if (img_shadow == NULL) img_shadow = CP_Image_Load("Assets/shadow.png");
-    if (img_lich == NULL)   img_lich = CP_Image_Load("Assets/lich.png");
-    if (img_heart_particle == NULL) img_heart_particle = CP_Image_Load("Assets/icon_heart.png");
-    if (img_shield_particle == NULL) img_shield_particle = CP_Image_Load("Assets/icon_shield.png");
-
-    int clamped_health = (health < 0) ? 0 : health;
-    if (clamped_health > max_health) clamped_health = max_health;
-
-    float ratio = (max_health > 0) ? ((float)clamped_health / (float)max_health) : 0.0f;
-
     CP_Settings_RectMode(CP_POSITION_CORNER);
 
     // Draw Selection Highlight
@@ -587,26 +650,27 @@ static void DrawEntity(const char* name, int health, int max_health,
     CP_Settings_StrokeWeight(0);
 
     // Draw Sprite based on name
-    CP_Image current_sprite = NULL;
-    if (strcmp(name, "Player") == 0) current_sprite = img_player;
-    else if (strstr(name, "Goblin") != NULL) current_sprite = img_goblin;
-    else if (strstr(name, "Slime") != NULL)  current_sprite = img_slime;
-    else if (strstr(name, "Witch") != NULL)  current_sprite = img_witch;
-    else if (strstr(name, "Orc") != NULL)    current_sprite = img_orc;
-    else if (strstr(name, "Ogre") != NULL)   current_sprite = img_ogre;
-    else if (strstr(name, "OGRE") != NULL)   current_sprite = img_ogre;
-    else if (strstr(name, "Shadow") != NULL) current_sprite = img_shadow;
-    else if (strstr(name, "LICH") != NULL)   current_sprite = img_lich;
-    else if (strstr(name, "Lich") != NULL)   current_sprite = img_lich;
-
-    if (current_sprite != NULL) {
-        CP_Image_Draw(current_sprite, x + w / 2.0f, y + h / 2.0f, w, h, 255);
+    SpriteId sprite = Sprite_ForName(name);
+    if (Sprite_Width(sprite) > 0.0f) {
+        Sprite_Draw(sprite, x + w / 2.0f, y + h / 2.0f, w, h, 255);
     }
     else {
         // Fallback rectangle
         CP_Settings_Fill(model_color);
         CP_Graphics_DrawRect(x, y, w, h);
     }
+}
+
+// Draws what goes on top of a character once the sprite batch is flushed: slash, health bar, name and stats.
+static void DrawEntityOverlay(const char* name, int health, int max_health,
+    int attack, int shield, float x, float y, float w, float h, float slash_timer)
+{
+    int clamped_health = (health < 0) ? 0 : health;
+    if (clamped_health > max_health) clamped_health = max_health;
+
+    float ratio = (max_health > 0) ? ((float)clamped_health / (float)max_health) : 0.0f;
+
+    CP_Settings_RectMode(CP_POSITION_CORNER);
 
     // Draw Slash effect (visual line across entity)
     if (slash_timer > 0.0f) {
@@ -663,14 +727,33 @@ static void DrawEntity(const char* name, int health, int max_health,
     }
 }
 
-// Manages the enemy turn sequence: Animation -> Damage Calculation -> Next Enemy.
-void UpdateEnemyTurn(void) {
+// Enemy turn spans open in the timeline (trace.h): the whole turn, and the acting enemy's attack
+static bool enemy_turn_traced = false;
+static char enemy_attack_traced[32] = "";
+
+static void TraceEnemyAttackEnd(void) {
+    if (!enemy_attack_traced[0]) return;
+    Trace_AsyncEnd(TRACE_CAT_ENEMY, enemy_attack_traced, TRACE_ID_ENEMY_TURN);
+    enemy_attack_traced[0] = '\0';
+}
+
+static void TraceEnemyTurnEnd(void) {
+    TraceEnemyAttackEnd();
+    if (enemy_turn_traced) Trace_AsyncEnd(TRACE_CAT_ENEMY, "Enemy turn", TRACE_ID_ENEMY_TURN);
+    enemy_turn_traced = false;
+}
+
+// Manages the enemy turn sequence: Animation -> Damage Calculation -> Next Enemy. Runs once per logic tick.
+void UpdateEnemyTurn(float dt) {
     if (!current_enemies) {
         current_phase = PHASE_PLAYER;
         return;
     }
-    float dt = CP_System_GetDt();
     enemy_turn_timer += dt;
+    if (!enemy_turn_traced) {
+        Trace_AsyncBegin(TRACE_CAT_ENEMY, "Enemy turn", TRACE_ID_ENEMY_TURN);
+        enemy_turn_traced = true;
+    }
 
     // Check if all enemies have acted
     if (enemy_action_index >= current_enemy_count) {
@@ -683,36 +766,23 @@ void UpdateEnemyTurn(void) {
         enemy_has_hit = false;
 
         // Handle Enrage Mechanic (Bosses gain ATK every turn)
-        if (current_enemies) {
-            for (int i = 0; i < current_enemy_count; i++) {
-                if (current_enemies[i].alive && current_enemies[i].enrages) {
-                    current_enemies[i].attack += current_enemies[i].enrage_amount;
-                    // Visual feedback for enrage
-                    float ww = (float)CP_System_GetWindowWidth();
-                    float wh = (float)CP_System_GetWindowHeight();
-                    float enemy_width = 120.0f;
-                    float spacing = 40.0f;
-                    float total_width = (float)current_enemy_count * enemy_width + ((float)current_enemy_count - 1.0f) * spacing;
-                    float start_x = ww - total_width - 200.0f;
-                    float enemy_x = start_x + (float)i * (enemy_width + spacing);
-                    float enemy_y = wh / 2.0f - 160.0f / 2.0f;
-                    char enrage_text[16];
-                    snprintf(enrage_text, sizeof(enrage_text), "ATK +%d", current_enemies[i].enrage_amount);
-                    SpawnFloatingText(enrage_text, CP_Vector_Set(enemy_x + 60.0f, enemy_y), CP_Color_Create(255, 100, 100, 255));
-                }
-            }
-        }
+        Combat_EndEnemyTurn(&combat);
+        TraceEnemyTurnEnd();
         return;
     }
 
     // Get current acting enemy
-    Enemy* e = &current_enemies[enemy_action_index];
-    if (!e->alive) {
+    if (!current_enemies->alive[enemy_action_index]) {
         enemy_action_index++;
         enemy_turn_timer = 0.0f;
         return;
     }
 
+    if (!enemy_attack_traced[0] && Trace_Enabled()) {
+        snprintf(enemy_attack_traced, sizeof(enemy_attack_traced), "Enemy %d attack", enemy_action_index + 1);
+        Trace_AsyncBegin(TRACE_CAT_ENEMY, enemy_attack_traced, TRACE_ID_ENEMY_TURN);
+    }
+
     // 1. Move Forward (Lunge)
     if (enemy_turn_timer < 0.3f) {
         float ratio = enemy_turn_timer / 0.3f;
@@ -722,28 +792,9 @@ void UpdateEnemyTurn(void) {
     else if (!enemy_has_hit) {
         enemy_has_hit = true;
         enemy_anim_offset_x = -200.0f;
-        int damage_to_deal = e->attack;
-        int damage_blocked = 0;
-        int damage_dealt = 0;
-        // Apply Shield Mitigation
-        if (player.shield > 0) {
-            damage_blocked = (damage_to_deal <= player.shield) ? damage_to_deal : player.shield;
-            player.shield -= damage_blocked;
-            player_shield_flash = 0.2f;
-        }
-        damage_dealt = damage_to_deal - damage_blocked;
-
-        // Apply Damage to Health
-        if (damage_dealt > 0) {
-            player.health -= damage_dealt;
-            player_hit_flash = 0.2f;
-            char text[16];
-            snprintf(text, sizeof(text), "-%d", damage_dealt);
-            SpawnFloatingText(text, CP_Vector_Set(175.0f, CP_System_GetWindowHeight() / 2.0f), CP_Color_Create(255, 80, 80, 255));
-        }
-        else {
-            SpawnFloatingText("Block!", CP_Vector_Set(175.0f, CP_System_GetWindowHeight() / 2.0f), CP_Color_Create(150, 150, 255, 255));
-        }
+        Trace_Begin(TRACE_CAT_ENEMY, "Enemy hit");
+        Combat_EnemyAttack(&combat, enemy_action_index);
+        Trace_End(TRACE_CAT_ENEMY, "Enemy hit");
     }
     // 3. Move Back
     else if (enemy_turn_timer < 0.6f) {
@@ -752,6 +803,7 @@ void UpdateEnemyTurn(void) {
     }
     // 4. End Turn for this Enemy
     else {
+        TraceEnemyAttackEnd();
         enemy_action_index++;
         enemy_turn_timer = 0.0f;
         enemy_anim_offset_x = 0.0f;
@@ -763,34 +815,40 @@ void UpdateEnemyTurn(void) {
 // 3. INITIALIZATION
 // ---------------------------------------------------------
 
-// Called once when the game state starts. Loads assets and sets up the board.
-void Game_Init(void)
+void Game_Preload(void)
 {
-    game_bg = CP_Image_Load("Assets/background.png");
+    Asset_Preload(ASSET_IMAGE, GAME_BG_PATH);
+    Asset_Preload(ASSET_MUSIC, GAME_MUSIC_PATH);
+    Asset_Preload(ASSET_FONT, GAME_FONT_PATH);
+    Audio_Preload();
+    Sprite_Preload();
+}
 
-    if (background_music == NULL)
-    {
-        background_music = CP_Sound_LoadMusic("Assets/background_music.wav");
+// Called once when the game state starts. Acquires assets (preloaded during the intro) and sets up the board.
+void Game_Init(void)
+{
+    Trace_AsyncBegin(TRACE_CAT_STATE, "Game", TRACE_ID_SCREEN);
+    game_bg_id = Asset_Acquire(ASSET_IMAGE, GAME_BG_PATH);
+    game_bg = Asset_Image(game_bg_id);
 
-        if (background_music == NULL) {
-            printf("Error: Could not load Assets/background_music.wav\n");
-            CP_Engine_Terminate();
-        }
+    background_music_id = Asset_Acquire(ASSET_MUSIC, GAME_MUSIC_PATH);
+    background_music = Asset_Sound(background_music_id);
+    if (background_music == NULL) {
+        printf("Error: Could not load " GAME_MUSIC_PATH "\n");
+        CP_Engine_Terminate();
     }
 
     Audio_Init();
-
-    // Load SFX
-    sfx_shield = CP_Sound_Load("Assets/shield_sfx.ogg");
-    sfx_heal = CP_Sound_Load("Assets/heal_sfx.ogg");
-    sfx_draw = CP_Sound_Load("Assets/card_in.ogg");
+    Sprite_Load();
+    Profiler_Init(section_names, SECTION_COUNT);
 
     // 2. Play the music ONCE here, not in Update
     // This function usually loops music automatically
     if (background_music != NULL) {
         CP_Sound_PlayMusic(background_music);
     }
-    game_font = CP_Font_Load("Assets/Exo2-Regular.ttf");
+    game_font_id = Asset_Acquire(ASSET_FONT, GAME_FONT_PATH);
+    game_font = Asset_Font(game_font_id);
     if (game_font != 0) { CP_Font_Set(game_font); CP_Settings_TextSize(24); }
 
     deck_pos = CP_Vector_Set(50, 550);
@@ -798,14 +856,17 @@ void Game_Init(void)
 
     InitReward(&reward_state);
     InitBuffReward(&buff_reward_state);
+    Timestep_Init(&game_clock, instant_mode);
+    EventBus_Init(&combat_events);
 
     // Check if we are restarting from a death (Checkpoint) or a fresh game
     if (g_is_restarting_from_checkpoint) {
         g_is_restarting_from_checkpoint = false;
         // Restore health but keep buffs/progress
         player.health = player.max_health;
-        player.shield = START_SHIELD;
+        player.shield = PLAYER_START_SHIELD;
         hand_size = 0;
+        hand_hash = 0;
         discard_size = 0;
         dealt = false;
         turn_num = 0;
@@ -813,13 +874,15 @@ void Game_Init(void)
         selected_card_index = -1;
         recycling_count = 0;
         is_recycling = false;
+        Replay_Record(&replay_log, REPLAY_RESTART, player.checkpoint_level, 0, 0);
         LoadLevel(player.checkpoint_level);
     }
     else {
         // Reset everything
         ResetGame();
+        StartRunStreams();
         InitDeck(&player_deck);
-        ShuffleDeck(&player_deck);
+        ShuffleDeck(&player_deck, &game_rng[RNG_STREAM_SHUFFLE]);
         LoadLevel(current_level);
     }
 }
@@ -835,13 +898,151 @@ static int GetActiveHandSize(void) {
     return count;
 }
 
+// Converts a hand array slot to its index among the cards still in hand, as replay logs count them.
+static int ActiveHandIndex(int slot) {
+    if (slot < 0) return -1;
+    int index = 0;
+    for (int i = 0; i < slot; i++) {
+        if (!hand[i].is_discarding) index++;
+    }
+    return index;
+}
+
+// Sends a hand card flying to the discard pile and takes it out of hand_hash. The card stays in hand[]
+// until it lands (Card Logic in Game_Update).
+static void SendToDiscard(Card* card) {
+    if (!card->is_discarding) hand_hash -= CardHashKey(card->id);
+    card->is_discarding = true;
+    card->is_animating = true;
+    card->target_pos = CP_Vector_Set(
+        discard_pos.x + (CARD_W_INIT * CARD_SCALE) / 2.0f,
+        discard_pos.y + (CARD_H_INIT * CARD_SCALE) / 2.0f
+    );
+}
+
+// Developer Mode: recomputes the combat and hand hashes from scratch and reports (then repairs) any
+// drift in the incrementally updated ones.
+static void CheckHashes(void) {
+    uint64_t full_hand_hash = 0;
+    for (int i = 0; i < hand_size; i++) {
+        if (!hand[i].is_discarding) full_hand_hash += CardHashKey(hand[i].id);
+    }
+    if (full_hand_hash != hand_hash) {
+        printf("WARNING: hand hash drifted on turn %d (%016llx, expected %016llx)\n",
+            turn_num, (unsigned long long)hand_hash, (unsigned long long)full_hand_hash);
+        hand_hash = full_hand_hash;
+    }
+    uint64_t full_combat_hash = Zobrist_HashCombat(&player, current_enemies);
+    if (full_combat_hash != combat.hash) {
+        printf("WARNING: combat hash drifted on turn %d (%016llx, expected %016llx)\n",
+            turn_num, (unsigned long long)combat.hash, (unsigned long long)full_combat_hash);
+        Combat_Rehash(&combat);
+    }
+}
+
+// Logs the highlighted card and the target whenever the player changed them.
+static void RecordSelection(void) {
+    int card = (selected_card_index >= 0 && selected_card_index < hand_size && !hand[selected_card_index].is_discarding)
+        ? ActiveHandIndex(selected_card_index) : -1;
+    if (card != replay_card) {
+        Replay_Record(&replay_log, REPLAY_SELECT, card, 0, 0);
+        replay_card = card;
+    }
+    if (selected_enemy != replay_target) {
+        Replay_Record(&replay_log, REPLAY_TARGET, selected_enemy, 0, 0);
+        replay_target = selected_enemy;
+    }
+}
+
+// Asks the turn solver for the best next play and selects it (card and target) for the player.
+static void ShowTurnHint(void) {
+    if (!hint_search) hint_search = Ai_Create(AI_TT_BITS_DEFAULT);
+    if (!hint_search) return;
+
+    // Only cards still in hand count; remember where each one sits in the hand array
+    RunCard cards[MAX_HAND_SIZE];
+    int hand_slot[MAX_HAND_SIZE];
+    int count = 0;
+    for (int i = 0; i < hand_size; i++) {
+        if (hand[i].is_discarding) continue;
+        const CardDef* def = CardDef_Get(hand[i].id);
+        cards[count].type = def->type;
+        cards[count].effect = def->effect;
+        cards[count].power = def->power;
+        hand_slot[count++] = i;
+    }
+
+    AiBudget budget = { 0, HINT_MAX_SECONDS };
+    AiMove move = Ai_FindBestMove(hint_search, &player, current_enemies, cards, count, played_cards, budget);
+
+    float wh = (float)CP_System_GetWindowHeight();
+    CP_Vector text_pos = CP_Vector_Set(175.0f, wh / 2.0f - 140.0f);
+    if (move.hand_index < 0) {
+        selected_card_index = -1;
+        SpawnFloatingText("Hint: End Turn", text_pos, CP_Color_Create(255, 255, 0, 255));
+        return;
+    }
+    selected_card_index = hand_slot[move.hand_index];
+    if (move.target >= 0) selected_enemy = move.target;
+    SpawnFloatingText("Hint!", text_pos, CP_Color_Create(255, 255, 0, 255));
+}
+
+// One fixed logic step of everything that runs on time: flashes, the stage clear banner, the enemy
+// turn, card movement and floating text. Input and rendering stay once per frame in Game_Update.
+static void TickAnimations(float dt) {
+    enemy_anim_prev_x = enemy_anim_offset_x;
+
+    // Flash effects
+    if (player_hit_flash > 0.0f) player_hit_flash -= dt;
+    if (player_shield_flash > 0.0f) player_shield_flash -= dt;
+    if (current_enemies) {
+        for (int i = 0; i < current_enemy_count; i++) {
+            if (enemy_hit_flash[i] > 0.0f) enemy_hit_flash[i] -= dt;
+            if (enemy_shield_flash[i] > 0.0f) enemy_shield_flash[i] -= dt;
+            if (enemy_slash_timer[i] > 0.0f) enemy_slash_timer[i] -= dt;
+        }
+    }
+    UpdateFloatingText(dt);
+    UpdateFloatingIcons(dt);
+
+    if (stage_cleared && banner_timer > 0.0f) banner_timer -= dt;
+    // Everything below is paused by the stage clear and reward screens and by a game over
+    if (stage_cleared || reward_active || buff_reward_active || player.health <= 0) return;
+    if (Combat_AllEnemiesDefeated(&combat)) return;
+
+    if (current_phase == PHASE_ENEMY) UpdateEnemyTurn(dt);
+
+    for (int i = 0; i < hand_size; ++i) {
+        if (hand[i].is_animating) AnimateMoveCard(&hand[i], 900, dt);
+    }
+
+    // use custom discard speed and animate the cards and set discard cards to deck
+    if (is_recycling) {
+        for (int i = 0; i < discard_size; i++) {
+            AnimateMoveCard(&discard[i], 300, dt);
+            if (!discard[i].is_animating) {
+                RecycleDeck(discard, &player_deck, &discard_size, &game_rng[RNG_STREAM_SHUFFLE]);
+                is_recycling = false;
+            }
+        }
+    }
+}
+
 // ---------------------------------------------------------
 // 4. GAME UPDATE LOOP
 // ---------------------------------------------------------
 
-// Main loop called every frame. Handles Logic, Input, and Rendering.
-void Game_Update(void) {
-    float dt = CP_System_GetDt();
+// One frame of logic, input and rendering. Profiler_Mark starts the timing of each numbered step.
+static void UpdateFrame(void) {
+    // Run the logic ticks this frame's time covers, then draw between the last two
+    Profiler_Mark(SECTION_TICKS);
+    int ticks = Timestep_Advance(&game_clock, CP_System_GetDt());
+    for (int t = 0; t < ticks; t++) TickAnimations(Timestep_TickDt(&game_clock));
+    float alpha = Timestep_Alpha(&game_clock);
+    PresentCombatEvents();
+    Sprite_BeginFrame();
+    Text_BeginFrame();
+
     float ww = (float)CP_System_GetWindowWidth();
     float wh = (float)CP_System_GetWindowHeight();
     float mx = (float)CP_Input_GetMouseX();
@@ -849,11 +1050,14 @@ void Game_Update(void) {
     int mouse_clicked = CP_Input_MouseClicked();
     bool hand_needs_realignment = false;
 
-    // 1. Background    
+    // 1. Background (card faces bake into the back buffer first, the clear covers them)
+    Profiler_Mark(SECTION_BACKGROUND);
+    BakeCardFaces();
     CP_Graphics_ClearBackground(CP_Color_Create(20, 25, 28, 255));
-    if (game_bg) CP_Image_Draw(game_bg, ww * 0.5f, wh * 0.5f, ww, wh, 255);
+    Sprite_DrawImage(game_bg, ww * 0.5f, wh * 0.5f, ww, wh, 255);
 
     // 2. Overlays & Game State Checks
+    Profiler_Mark(SECTION_STATE_CHECKS);
     // If showing a banner or reward screen, block normal gameplay
     if (UpdateStageClear() == 1) {
         // Ensure hand is cleared into deck for next level
@@ -862,7 +1066,8 @@ void Game_Update(void) {
             discard_size++;
         }
         hand_size = 0;
-        RecycleDeck(discard, &player_deck, &discard_size);
+        hand_hash = 0;
+        RecycleDeck(discard, &player_deck, &discard_size, &game_rng[RNG_STREAM_SHUFFLE]);
 
         return;
     }
@@ -874,38 +1079,22 @@ void Game_Update(void) {
             discard_size++;
         }
         hand_size = 0;
-        RecycleDeck(discard, &player_deck, &discard_size);
+        hand_hash = 0;
+        RecycleDeck(discard, &player_deck, &discard_size, &game_rng[RNG_STREAM_SHUFFLE]);
+        Replay_Record(&replay_log, REPLAY_DEATH, current_level, 0, 0);
         CP_Engine_SetNextGameState(GameOver_Init, GameOver_Update, GameOver_Exit);
         return;
     }
 
-    // 3. Update Timers (Flash effects)
-    if (player_hit_flash > 0.0f) player_hit_flash -= dt;
-    if (player_shield_flash > 0.0f) player_shield_flash -= dt;
-    if (current_enemies) {
-        for (int i = 0; i < current_enemy_count; i++) {
-            if (enemy_hit_flash[i] > 0.0f) enemy_hit_flash[i] -= dt;
-            if (enemy_shield_flash[i] > 0.0f) enemy_shield_flash[i] -= dt;
-            if (enemy_slash_timer[i] > 0.0f) enemy_slash_timer[i] -= dt;
-        }
-    }
+    // 3. Timers, the enemy turn and card movement advance in TickAnimations
 
     // 4. Phase Logic
-    if (current_phase == PHASE_ENEMY) {
-        UpdateEnemyTurn();
-    }
-    else {
+    Profiler_Mark(SECTION_PHASE);
+    if (current_phase == PHASE_PLAYER) {
         // Player Turn: Update targeting logic
-        int living_enemies = 0;
-        if (current_enemies) {
-            for (int i = 0; i < current_enemy_count; i++) {
-                if (current_enemies[i].alive) {
-                    living_enemies++;
-                }
-            }
-        }
+        int living_enemies = Combat_LivingEnemyCount(&combat);
         // Auto-select valid enemy if current target is dead or invalid
-        if (selected_enemy == -1 || (current_enemies && !current_enemies[selected_enemy].alive)) {
+        if (selected_enemy == -1 || (current_enemies && !current_enemies->alive[selected_enemy])) {
             HandleEnemySelection();
         }
         else if (living_enemies > 1) {
@@ -913,82 +1102,92 @@ void Game_Update(void) {
         }
     }
 
-    // 5. Render Player
-    DrawEntity("Player", player.health, player.max_health,
-        player.attack, player.shield,
-        100.0f, wh / 2.0f - 100.0f, 150.0f, 200.0f,
-        CP_Color_Create(50, 50, 150, 255),
-        0,
-        player_hit_flash, player_shield_flash, 0.0f);
+    // 5-6. Render Player and Enemies. The sprites go out as one batch, the bars and text on top.
+    Profiler_Mark(SECTION_ENTITIES);
+    float player_x = 100.0f, player_y = wh / 2.0f - 100.0f, player_w = 150.0f, player_h = 200.0f;
+    float enemy_x[16];
+    for (int i = 0; i < current_enemy_count && current_enemies; i++) {
+        enemy_x[i] = EnemyScreenPos(i).x;
+        // Apply lunge animation offset
+        if (current_phase == PHASE_ENEMY && i == enemy_action_index && current_enemies->alive[i]) {
+            enemy_x[i] += enemy_anim_prev_x + (enemy_anim_offset_x - enemy_anim_prev_x) * alpha;
+        }
+    }
 
-    // 6. Render Enemies
-    if (current_enemies && current_enemy_count > 0) {
-        float enemy_width = 120.0f;
-        float enemy_height = 160.0f;
-        float spacing = 40.0f;
-        float start_x = ww - (float)current_enemy_count * enemy_width - 200.0f;
-        float y = wh / 2.0f - enemy_height / 2.0f;
+    Sprite_BeginBatch();
+    DrawEntityBody("Player", player_x, player_y, player_w, player_h,
+        CP_Color_Create(50, 50, 150, 255), 0, player_hit_flash, player_shield_flash);
+    for (int i = 0; i < current_enemy_count && current_enemies; i++) {
+        bool alive = current_enemies->alive[i] != 0;
+        CP_Color col = alive ? CP_Color_Create(120, 120, 120, 255) : CP_Color_Create(80, 80, 80, 150);
+        DrawEntityBody(current_enemies->templates[i]->name, enemy_x[i], EnemyScreenPos(i).y, ENEMY_W, ENEMY_H, col,
+            (selected_enemy == i), enemy_hit_flash[i], enemy_shield_flash[i]);
+    }
+    Sprite_Flush();
 
-        for (int i = 0; i < current_enemy_count; i++) {
-            Enemy* e = &current_enemies[i];
-            float x = start_x + i * (enemy_width + spacing);
-            // Apply lunge animation offset
-            if (current_phase == PHASE_ENEMY && i == enemy_action_index && e->alive) {
-                x += enemy_anim_offset_x;
-            }
-            CP_Color col = e->alive ? CP_Color_Create(120, 120, 120, 255) : CP_Color_Create(80, 80, 80, 150);
-            DrawEntity(e->name, e->health, e->max_health, e->attack, e->shield,
-                x, y, enemy_width, enemy_height, col,
-                (selected_enemy == i), enemy_hit_flash[i], enemy_shield_flash[i], enemy_slash_timer[i]);
-        }
+    DrawEntityOverlay("Player", player.health, player.max_health, player.attack, player.shield,
+        player_x, player_y, player_w, player_h, 0.0f);
+    for (int i = 0; i < current_enemy_count && current_enemies; i++) {
+        const Enemy* e = current_enemies->templates[i];
+        DrawEntityOverlay(e->name, current_enemies->health[i], e->max_health, current_enemies->attack[i], current_enemies->shield[i],
+            enemy_x[i], EnemyScreenPos(i).y, ENEMY_W, ENEMY_H, enemy_slash_timer[i]);
     }
 
-    // 7. Draw HUD (Text overlays)
-    char hud_text[128];
-    snprintf(hud_text, sizeof(hud_text), "Level %d | Turn %d", current_level, turn_num + 1);
-    CP_Settings_TextAlignment(CP_TEXT_ALIGN_H_LEFT, CP_TEXT_ALIGN_V_TOP);
-    CP_Settings_Fill(CP_Color_Create(255, 255, 0, 255));
-    CP_Font_Set(game_font);
-    CP_Settings_TextSize(30);
-    CP_Font_DrawText(hud_text, 20, 35);
+    // 7. Draw HUD (Text overlays). The numbered lines are only re-formatted when their numbers change.
+    Profiler_Mark(SECTION_HUD);
+    static TextLine level_line, restarts_line;
+    TextStyle hud_style = { game_font, 30.0f, CP_TEXT_ALIGN_H_LEFT, CP_TEXT_ALIGN_V_TOP, CP_Color_Create(255, 255, 0, 255) };
+    Text_Begin();
+    Text_Draw(&hud_style, Text_Format(&level_line, "Level %d | Turn %d", current_level, turn_num + 1), 20, 35);
 
-    char death_text[32];
-    snprintf(death_text, sizeof(death_text), "Restarts: %d", player.death_count);
-    CP_Settings_TextAlignment(CP_TEXT_ALIGN_H_RIGHT, CP_TEXT_ALIGN_V_TOP);
-    CP_Font_DrawText(death_text, ww - 20.0f, 35.0f);
+    hud_style.align_h = CP_TEXT_ALIGN_H_RIGHT;
+    Text_Draw(&hud_style, Text_Format(&restarts_line, "Restarts: %d", player.death_count, 0), ww - 20.0f, 35.0f);
 
     // Draw Buff List (Active Passive Effects)
     float buff_text_y = 70.0f;
-    CP_Settings_TextSize(18);
-    CP_Settings_TextAlignment(CP_TEXT_ALIGN_H_LEFT, CP_TEXT_ALIGN_V_TOP);
-    CP_Settings_Fill(CP_Color_Create(0, 255, 255, 255));
-    if (player.has_lifesteal) { CP_Font_DrawText("Buff: Vampiric Strike (50% Lifesteal)", 20, buff_text_y); buff_text_y += 25.0f; }
-    if (player.has_desperate_draw) { CP_Font_DrawText("Buff: Card Mastery (+1 Card Draw)", 20, buff_text_y); buff_text_y += 25.0f; }
-    if (player.has_divine_strike) { CP_Font_DrawText("Buff: Divine Strike (Heal deals 50% AOE damage)", 20, buff_text_y); buff_text_y += 25.0f; }
-    if (player.has_shield_boost) { CP_Font_DrawText("Buff: Reinforce (25% Bonus Shield)", 20, buff_text_y); buff_text_y += 25.0f; }
-    if (player.has_attack_boost_35) { CP_Font_DrawText("Buff: Power Infusion (35% Bonus Attack)", 20, buff_text_y); buff_text_y += 25.0f; }
-    if (player.has_heal_boost_35) { CP_Font_DrawText("Buff: Holy Infusion (35% Bonus Heal)", 20, buff_text_y); buff_text_y += 25.0f; }
-    if (player.has_shield_boost_35) { CP_Font_DrawText("Buff: Barrier Infusion (35% Bonus Shield)", 20, buff_text_y); buff_text_y += 25.0f; }
-
-    UpdateAndDrawFloatingText();
-    UpdateAndDrawFloatingIcons();
+    TextStyle buff_style = { game_font, 18.0f, CP_TEXT_ALIGN_H_LEFT, CP_TEXT_ALIGN_V_TOP, CP_Color_Create(0, 255, 255, 255) };
+    if (player.has_lifesteal) { Text_Draw(&buff_style, "Buff: Vampiric Strike (50% Lifesteal)", 20, buff_text_y); buff_text_y += 25.0f; }
+    if (player.has_desperate_draw) { Text_Draw(&buff_style, "Buff: Card Mastery (+1 Card Draw)", 20, buff_text_y); buff_text_y += 25.0f; }
+    if (player.has_divine_strike) { Text_Draw(&buff_style, "Buff: Divine Strike (Heal deals 50% AOE damage)", 20, buff_text_y); buff_text_y += 25.0f; }
+    if (player.has_shield_boost) { Text_Draw(&buff_style, "Buff: Reinforce (25% Bonus Shield)", 20, buff_text_y); buff_text_y += 25.0f; }
+    if (player.has_attack_boost_35) { Text_Draw(&buff_style, "Buff: Power Infusion (35% Bonus Attack)", 20, buff_text_y); buff_text_y += 25.0f; }
+    if (player.has_heal_boost_35) { Text_Draw(&buff_style, "Buff: Holy Infusion (35% Bonus Heal)", 20, buff_text_y); buff_text_y += 25.0f; }
+    if (player.has_shield_boost_35) { Text_Draw(&buff_style, "Buff: Barrier Infusion (35% Bonus Shield)", 20, buff_text_y); buff_text_y += 25.0f; }
+
+    // Developer Mode: what the last frame cost to draw
+    if (developer) {
+        SpriteStats sprite_stats = Sprite_FrameStats();
+        TextStats text_stats = Text_FrameStats();
+        char stats_text[128];
+        TextStyle stats_style = { game_font, 18.0f, CP_TEXT_ALIGN_H_RIGHT, CP_TEXT_ALIGN_V_BOTTOM, CP_Color_Create(255, 255, 255, 255) };
+        snprintf(stats_text, sizeof(stats_text), "Image draws %d | Texture switches %d | Sprites %d in %d batches",
+            sprite_stats.image_draws, sprite_stats.texture_switches, sprite_stats.sprites, sprite_stats.batches);
+        Text_Draw(&stats_style, stats_text, ww - 20.0f, wh - 35.0f);
+        snprintf(stats_text, sizeof(stats_text), "Text draws %d | State changes %d (%d skipped) | Lines formatted %d",
+            text_stats.draws, text_stats.state_changes, text_stats.state_skipped, text_stats.formats);
+        Text_Draw(&stats_style, stats_text, ww - 20.0f, wh - 10.0f);
+    }
+
+    DrawFloatingText();
+    DrawFloatingIcons();
 
     // 8. Card Logic (Discarding & Cleanup)
+    Profiler_Mark(SECTION_CARD_CLEANUP);
+    // One pass: discarded cards go to the discard array, the rest are packed down in order
+    int kept = 0;
     for (int i = 0; i < hand_size; i++) {
         // Move card from hand array to discard array if it is discarding
         if (hand[i].is_discarding && !hand[i].is_animating) {
             discard[discard_size] = hand[i];
             discard[discard_size].is_discarding = false;
             discard_size++;
-            // Shift remaining cards down
-            for (int j = i; j < hand_size - 1; j++) {
-                hand[j] = hand[j + 1];
-            }
-            hand_size--;
             hand_needs_realignment = true;
-            i--;
+            continue;
         }
+        if (kept != i) hand[kept] = hand[i];
+        kept++;
     }
+    hand_size = kept;
     // Re-calculate card positions if cards were removed
     if (hand_needs_realignment) {
         SetHandPos(hand, hand_size);
@@ -1001,6 +1200,7 @@ void Game_Update(void) {
     }
 
     // 9. Draw Deck Piles
+    Profiler_Mark(SECTION_PILES);
     CP_Settings_RectMode(CP_POSITION_CORNER);
     CP_Settings_Stroke(CP_Color_Create(0, 0, 0, 255));
     CP_Settings_Fill(CP_Color_Create(145, 145, 145, 255));
@@ -1021,15 +1221,15 @@ void Game_Update(void) {
     CP_Font_DrawText(count_text, discard_pos.x + ((CARD_W_INIT * CARD_SCALE) / 2.0f), discard_pos.y + ((CARD_H_INIT * CARD_SCALE) / 2.0f));
 
     // 10. Deal Cards (Start of Turn)
+    Profiler_Mark(SECTION_DEAL);
     if (!dealt) {
-        int cards_to_draw = 4;
-        if (player.has_desperate_draw) {
-            cards_to_draw = 5; // Draw 1 extra card with buff
-        }
+        int cards_to_draw = Progression_CardsPerTurn(&player); // 1 extra card with Card Mastery
         // deal the cards
         for (int i = 0; i < cards_to_draw && player_deck.size > 0; i++) {
-            DealFromDeck(&player_deck, &hand[hand_size], &hand_size);
-            CP_Sound_Play(sfx_draw); // Play draw sound for each card
+            DealFromDeck(&player_deck, &hand[hand_size], &hand_size, &hand_hash);
+            const CardDef* dealt_def = CardDef_Get(hand[hand_size - 1].id);
+            Replay_Record(&replay_log, REPLAY_DEAL, dealt_def->type, dealt_def->effect, dealt_def->power);
+            Audio_Play(SFX_CARD_DRAW); // Play draw sound for each card
         }
 
         // set their hand position
@@ -1042,8 +1242,10 @@ void Game_Update(void) {
     }
 
     // 11. Draw Hand Cards
+    Profiler_Mark(SECTION_HAND);
     for (int i = 0; i < hand_size; ++i) {
-        if (hand[i].is_animating) AnimateMoveCard(&hand[i], 900);
+        Card drawn = hand[i];
+        drawn.pos = GetCardDrawPos(&hand[i], alpha);
 
         // Highlight selected card
         if (i == selected_card_index && !hand[i].is_discarding) {
@@ -1051,15 +1253,15 @@ void Game_Update(void) {
             CP_Settings_Stroke(CP_Color_Create(255, 255, 0, 255));
             CP_Settings_StrokeWeight(5.0f);
             CP_Settings_RectMode(CP_POSITION_CENTER);
-            CP_Graphics_DrawRect(hand[i].pos.x, hand[i].pos.y, hand[i].card_w + 5.0f, hand[i].card_h + 5.0f);
+            CP_Graphics_DrawRect(drawn.pos.x, drawn.pos.y, drawn.card_w + 5.0f, drawn.card_h + 5.0f);
         }
 
-        DrawCard(&hand[i]);
+        DrawCard(&drawn, &player);
     }
 
     // Highlight target (player or enemy) based on selected card type
     if (selected_card_index >= 0 && selected_card_index < hand_size && !hand[selected_card_index].is_discarding) {
-        Card* selected = &hand[selected_card_index];
+        const CardDef* selected = CardDef_Get(hand[selected_card_index].id);
 
         if (selected->type == Heal || selected->type == Shield) {
             // Highlight player (Self-targeting)
@@ -1075,6 +1277,7 @@ void Game_Update(void) {
     }
 
     // 12. Action Button (End Turn / Use Card)
+    Profiler_Mark(SECTION_ACTION_BUTTON);
     float select_btn_x = ww - 150.0f;
     float select_btn_y = wh - 100.0f;
     if (selected_card_index >= 0 || played_cards > 0 || hand_size > 0) {
@@ -1096,6 +1299,7 @@ void Game_Update(void) {
     }
 
     // 13. Input Logic (Mouse & Keyboard)
+    Profiler_Mark(SECTION_INPUT);
     bool card_played_this_frame = false;
     bool clicked_on_card_in_hand = false;
     if (current_phase == PHASE_PLAYER && mouse_clicked) {
@@ -1109,21 +1313,19 @@ void Game_Update(void) {
             }
         }
         // Check click on Player (to use Heal/Shield)
-        if (!clicked_on_card_in_hand && selected_card_index >= 0 && (hand[selected_card_index].type == Heal || hand[selected_card_index].type == Shield)) {
+        if (!clicked_on_card_in_hand && selected_card_index >= 0 && (CardDef_Get(hand[selected_card_index].id)->type == Heal || CardDef_Get(hand[selected_card_index].id)->type == Shield)) {
             float player_center_x = 100.0f + 150.0f / 2.0f;
             float player_center_y = (wh / 2.0f - 100.0f) + 200.0f / 2.0f;
             if (IsAreaClicked(player_center_x, player_center_y, 150.0f, 200.0f, mx, my)) card_played_this_frame = true;
         }
         // Check click on Enemy (to use Attack)
-        if (!clicked_on_card_in_hand && selected_card_index >= 0 && (hand[selected_card_index].type == Attack)) {
+        if (!clicked_on_card_in_hand && selected_card_index >= 0 && (CardDef_Get(hand[selected_card_index].id)->type == Attack)) {
             if (current_enemies) {
-                float enemy_width = 120.0f;
-                float spacing = 40.0f;
-                float start_x = ww - (float)current_enemy_count * enemy_width - 200.0f;
-                float enemy_y_center = (wh / 2.0f - 160.0f / 2.0f) + 160.0f / 2.0f;
                 for (int i = 0; i < current_enemy_count; i++) {
-                    float enemy_x_center = (start_x + i * (enemy_width + spacing)) + enemy_width / 2.0f;
-                    if (current_enemies[i].alive && IsAreaClicked(enemy_x_center, enemy_y_center, enemy_width, 160.0f, mx, my)) {
+                    CP_Vector enemy_pos = EnemyScreenPos(i);
+                    float enemy_x_center = enemy_pos.x + ENEMY_W / 2.0f;
+                    float enemy_y_center = enemy_pos.y + ENEMY_H / 2.0f;
+                    if (current_enemies->alive[i] && IsAreaClicked(enemy_x_center, enemy_y_center, ENEMY_W, ENEMY_H, mx, my)) {
                         selected_enemy = i;
                         card_played_this_frame = true;
                         break;
@@ -1136,18 +1338,14 @@ void Game_Update(void) {
             if (selected_card_index >= 0) card_played_this_frame = true;
             else {
                 // End Turn Button
+                Replay_Record(&replay_log, REPLAY_END_TURN, 0, 0, 0);
                 current_phase = PHASE_ENEMY;
                 enemy_action_index = 0;
                 enemy_turn_timer = 0.0f;
                 selected_card_index = -1;
                 // Discard all remaining hand cards
                 for (int i = 0; i < hand_size; i++) {
-                    hand[i].is_discarding = true;
-                    hand[i].is_animating = true;
-                    hand[i].target_pos = CP_Vector_Set(
-                        discard_pos.x + (CARD_W_INIT * CARD_SCALE) / 2.0f,
-                        discard_pos.y + (CARD_H_INIT * CARD_SCALE) / 2.0f
-                    );
+                    SendToDiscard(&hand[i]);
                 }
             }
         }
@@ -1159,266 +1357,36 @@ void Game_Update(void) {
             if (CP_Input_KeyTriggered(KEY_D)) { selected_card_index++; if (selected_card_index >= hand_size) selected_card_index = 0; }
         }
         if (CP_Input_KeyTriggered(KEY_S)) { if (selected_card_index >= 0 && !hand[selected_card_index].is_discarding) card_played_this_frame = true; }
+        if (CP_Input_KeyTriggered(KEY_H) && !card_played_this_frame) ShowTurnHint();
         if (CP_Input_KeyTriggered(KEY_ENTER)) {
             // End Turn
+            Replay_Record(&replay_log, REPLAY_END_TURN, 0, 0, 0);
             current_phase = PHASE_ENEMY;
             enemy_action_index = 0;
             enemy_turn_timer = 0.0f;
             selected_card_index = -1;
             for (int i = 0; i < hand_size; i++) {
-                hand[i].is_discarding = true;
-                hand[i].is_animating = true;
-                hand[i].target_pos = CP_Vector_Set(
-                    discard_pos.x + (CARD_W_INIT * CARD_SCALE) / 2.0f,
-                    discard_pos.y + (CARD_H_INIT * CARD_SCALE) / 2.0f
-                );
+                SendToDiscard(&hand[i]);
             }
         }
     }
 
+    if (current_phase == PHASE_PLAYER) RecordSelection();
+
     // 14. Execute Card Effects
+    Profiler_Mark(SECTION_CARD_EFFECTS);
     if (current_phase == PHASE_PLAYER && card_played_this_frame) {
         if (selected_card_index >= 0 && !hand[selected_card_index].is_discarding) {
             Card* card = &hand[selected_card_index];
-            Enemy* target_enemy = (current_enemies && selected_enemy >= 0 && selected_enemy < current_enemy_count) ? &current_enemies[selected_enemy] : NULL;
-            bool has_valid_target = (target_enemy && target_enemy->alive);
-
-            // Validation flags
-            bool can_play_shield = (card->type == Shield);
-            bool can_play_cleave = (card->type == Attack && card->effect == CLEAVE);
-            bool can_play_heal = (card->type == Heal);
-            bool can_play_attack = (card->type == Attack && card->effect != CLEAVE);
-
-            // Execute effect only if targets are valid
-            if (can_play_heal || can_play_shield || (can_play_attack && has_valid_target) || (can_play_cleave && has_valid_target)) {
-
-                int power = hand[selected_card_index].power;
-                int total_damage_dealt_this_card = 0;
-
-                // --- ATTACK LOGIC ---
-                if (card->type == Attack) {
-                    int damage_to_deal = power + player.attack_bonus;
-                    if (player.has_attack_boost_35) {
-                        damage_to_deal = (int)(damage_to_deal * 1.35f);
-                    }
-                    // Special Effect: CLEAVE (AOE)
-                    if (card->effect == CLEAVE) {
-                        if (damage_to_deal <= 0) damage_to_deal = 1;
-                        for (int i = 0; i < current_enemy_count; i++) {
-                            if (current_enemies[i].alive) {
-                                Enemy* cleave_target = &current_enemies[i];
-                                int damage_blocked = 0;
-                                int damage_dealt = 0;
-                                // Shield mitigation
-                                if (cleave_target->shield > 0) {
-                                    damage_blocked = (damage_to_deal <= cleave_target->shield) ? damage_to_deal : cleave_target->shield;
-                                    cleave_target->shield -= damage_blocked;
-                                    enemy_shield_flash[i] = 0.2f;
-                                }
-                                damage_dealt = damage_to_deal - damage_blocked;
-                                if (damage_dealt > 0) {
-                                    cleave_target->health -= damage_dealt;
-                                    enemy_hit_flash[i] = 0.2f;
-                                    enemy_slash_timer[i] = 0.3f;
-                                    total_damage_dealt_this_card += damage_dealt;
-
-                                    // Spawn floating number
-                                    float enemy_width = 120.0f;
-                                    float spacing = 40.0f;
-                                    float start_x = ww - (float)current_enemy_count * enemy_width - 200.0f;
-                                    float enemy_x = start_x + (float)i * (enemy_width + spacing);
-                                    float enemy_y = wh / 2.0f - 160.0f / 2.0f;
-                                    char dmg_text[16];
-                                    snprintf(dmg_text, sizeof(dmg_text), "-%d", damage_dealt);
-                                    SpawnFloatingText(dmg_text, CP_Vector_Set(enemy_x + 60.0f, enemy_y - 30.0f), CP_Color_Create(255, 80, 80, 255));
-                                }
-                                if (cleave_target->health <= 0) cleave_target->alive = false;
-                            }
-                        }
-                        // Lifesteal calculation (10% for AOE)
-                        if (total_damage_dealt_this_card > 0) {
-                            int lifesteal_amount = (int)(total_damage_dealt_this_card * 0.10f);
-                            if (lifesteal_amount < 1) lifesteal_amount = 1;
-                            player.health += lifesteal_amount;
-                            if (player.health > player.max_health) player.health = player.max_health;
-                            char heal_text[16];
-                            snprintf(heal_text, sizeof(heal_text), "+%d", lifesteal_amount);
-                            SpawnFloatingText(heal_text, CP_Vector_Set(175.0f, wh / 2.0f - 30.0f), CP_Color_Create(80, 255, 80, 255));
-                        }
-                    }
-                    // Normal Single Target Attack
-                    else {
-                        int damage_blocked = 0;
-                        int damage_dealt = 0;
-                        if (target_enemy->shield > 0) {
-                            damage_blocked = (damage_to_deal <= target_enemy->shield) ? damage_to_deal : target_enemy->shield;
-                            target_enemy->shield -= damage_blocked;
-                            enemy_shield_flash[selected_enemy] = 0.2f;
-                        }
-                        damage_dealt = damage_to_deal - damage_blocked;
-                        if (damage_dealt > 0) {
-                            target_enemy->health -= damage_dealt;
-                            enemy_hit_flash[selected_enemy] = 0.2f;
-                            enemy_slash_timer[selected_enemy] = 0.3f;
-
-                            // Lifesteal calculation (50% for Single Target if Buff active)
-                            if (player.has_lifesteal) {
-                                int lifesteal_amount = (int)(damage_dealt * 0.50f);
-                                if (lifesteal_amount < 1 && damage_dealt > 0) lifesteal_amount = 1;
-                                if (lifesteal_amount > 0) {
-                                    player.health += lifesteal_amount;
-                                    if (player.health > player.max_health) player.health = player.max_health;
-                                    CP_Sound_Play(sfx_heal);
-                                    char heal_text[16];
-                                    snprintf(heal_text, sizeof(heal_text), "+%d", lifesteal_amount);
-                                    SpawnFloatingText(heal_text, CP_Vector_Set(175.0f, wh / 2.0f - 30.0f), CP_Color_Create(80, 255, 80, 255));
-                                }
-                            }
-
-                            float enemy_width = 120.0f;
-                            float spacing = 40.0f;
-                            float start_x = ww - (float)current_enemy_count * enemy_width - 200.0f;
-                            float enemy_x = start_x + (float)selected_enemy * (enemy_width + spacing);
-                            float enemy_y = wh / 2.0f - 160.0f / 2.0f;
-                            char text[16];
-                            snprintf(text, sizeof(text), "-%d", damage_dealt);
-                            SpawnFloatingText(text, CP_Vector_Set(enemy_x + 60.0f, enemy_y), CP_Color_Create(255, 80, 80, 255));
-                        }
-                        else {
-                            // Blocked text
-                            float enemy_width = 120.0f;
-                            float spacing = 40.0f;
-                            float start_x = ww - (float)current_enemy_count * enemy_width - 200.0f;
-                            float enemy_x = start_x + (float)selected_enemy * (enemy_width + spacing);
-                            float enemy_y = wh / 2.0f - 160.0f / 2.0f;
-                            SpawnFloatingText("Block!", CP_Vector_Set(enemy_x + 60.0f, enemy_y), CP_Color_Create(150, 150, 255, 255));
-                        }
-                        if (target_enemy && target_enemy->health <= 0) target_enemy->alive = false;
-                    }
-                }
-                // --- HEAL LOGIC ---
-                else if (card->type == Heal) {
-                    int heal_amount = power + player.heal_bonus;
-                    if (player.has_heal_boost_35) {
-                        heal_amount = (int)(heal_amount * 1.35f);
-                    }
-                    player.health += heal_amount;
-                    if (player.health > player.max_health) player.health = player.max_health;
-
-                    CP_Sound_Play(sfx_heal); // Play heal sound
-
-                    char text[16];
-                    snprintf(text, sizeof(text), "+%d", heal_amount);
-                    SpawnFloatingText(text, CP_Vector_Set(175.0f, wh / 2.0f), CP_Color_Create(80, 255, 80, 255));
-
-                    // Particle effects
-                    for (int h = 0; h < 3; h++) {
-                        float offsetX = (float)(h * 30 - 30);
-                        float offsetY = (float)(h % 2 == 0 ? 0 : 15);
-                        SpawnFloatingIcon(img_heart_particle,
-                            CP_Vector_Set(175.0f + offsetX, wh / 2.0f + offsetY),
-                            0.3f);
-                    }
+            const CardDef* def = CardDef_Get(card->id);
 
-                    // Special Effect: DIVINE STRIKE (Heal damages enemies)
-                    if (player.has_divine_strike || card->effect == DIVINE_STRIKE_EFFECT) {
-                        int divine_damage = heal_amount / 2;
-                        if (divine_damage < 1 && heal_amount > 0) divine_damage = 1;
-                        if (divine_damage > 0 && current_enemies) {
-                            for (int i = 0; i < current_enemy_count; i++) {
-                                if (current_enemies[i].alive) {
-                                    Enemy* divine_target = &current_enemies[i];
-                                    int damage_blocked = 0;
-                                    int damage_dealt = 0;
-                                    if (divine_target->shield > 0) {
-                                        damage_blocked = (divine_damage <= divine_target->shield) ? divine_damage : divine_target->shield;
-                                        divine_target->shield -= damage_blocked;
-                                        enemy_shield_flash[i] = 0.2f;
-                                    }
-                                    damage_dealt = divine_damage - damage_blocked;
-                                    if (damage_dealt > 0) {
-                                        divine_target->health -= damage_dealt;
-                                        enemy_hit_flash[i] = 0.2f;
-                                        enemy_slash_timer[i] = 0.3f;
-
-                                        float enemy_width = 120.0f;
-                                        float spacing = 40.0f;
-                                        float start_x = ww - (float)current_enemy_count * enemy_width - 200.0f;
-                                        float enemy_x = start_x + (float)i * (enemy_width + spacing);
-                                        float enemy_y = wh / 2.0f - 160.0f / 2.0f;
-                                        char dmg_text[16];
-                                        snprintf(dmg_text, sizeof(dmg_text), "-%d", damage_dealt);
-                                        SpawnFloatingText(dmg_text, CP_Vector_Set(enemy_x + 60.0f, enemy_y - 30.0f), CP_Color_Create(255, 255, 100, 255));
-                                    }
-                                    if (divine_target->health <= 0) divine_target->alive = false;
-                                }
-                            }
-                        }
-                    }
-                }
-                // --- SHIELD LOGIC ---
-                else if (card->type == Shield) {
-                    int shield_amount = power + player.shield_bonus;
-                    if (player.has_shield_boost) {
-                        shield_amount = (int)(shield_amount * 1.25f);
-                    }
-                    if (player.has_shield_boost_35) {
-                        shield_amount = (int)(shield_amount * 1.35f);
-                    }
-                    player.shield += shield_amount;
-                    player_shield_flash = 0.2f;
-
-                    CP_Sound_Play(sfx_shield); // Play shield sound
-
-                    char text[16];
-                    snprintf(text, sizeof(text), "+%d", shield_amount);
-                    SpawnFloatingText(text, CP_Vector_Set(175.0f, wh / 2.0f), CP_Color_Create(80, 80, 255, 255));
-
-                    SpawnFloatingIcon(img_shield_particle, CP_Vector_Set(175.0f, wh / 2.0f), 0.4f);
-
-                    // Special Effect: SHIELD BASH (Shield damages enemies)
-                    if (card->effect == SHIELD_BASH) {
-                        int damage_to_deal = (int)(player.shield * 0.75f);
-                        if (damage_to_deal <= 0 && player.shield > 0) damage_to_deal = 1;
-                        for (int i = 0; i < current_enemy_count; i++) {
-                            if (current_enemies[i].alive) {
-                                Enemy* bash_target = &current_enemies[i];
-                                int damage_blocked = 0;
-                                int damage_dealt = 0;
-                                if (bash_target->shield > 0) {
-                                    damage_blocked = (damage_to_deal <= bash_target->shield) ? damage_to_deal : bash_target->shield;
-                                    bash_target->shield -= damage_blocked;
-                                    enemy_shield_flash[i] = 0.2f;
-                                }
-                                damage_dealt = damage_to_deal - damage_blocked;
-                                if (damage_dealt > 0) {
-                                    bash_target->health -= damage_dealt;
-                                    enemy_hit_flash[i] = 0.2f;
-                                    enemy_slash_timer[i] = 0.3f;
-
-                                    float enemy_width = 120.0f;
-                                    float spacing = 40.0f;
-                                    float start_x = ww - (float)current_enemy_count * enemy_width - 200.0f;
-                                    float enemy_x = start_x + (float)i * (enemy_width + spacing);
-                                    float enemy_y = wh / 2.0f - 160.0f / 2.0f;
-                                    char dmg_text[16];
-                                    snprintf(dmg_text, sizeof(dmg_text), "-%d", damage_dealt);
-                                    SpawnFloatingText(dmg_text, CP_Vector_Set(enemy_x + 60.0f, enemy_y - 30.0f), CP_Color_Create(255, 80, 80, 255));
-                                }
-                                if (bash_target->health <= 0) bash_target->alive = false;
-                            }
-                        }
-                    }
-                }
+            // Resolve the card through the rules; nothing happens if it has no valid target
+            if (Combat_ApplyCard(&combat, def->type, def->effect, def->power, selected_enemy)) {
+                Replay_Record(&replay_log, REPLAY_PLAY, ActiveHandIndex(selected_card_index), selected_enemy, 0);
 
                 // Cleanup after using card
                 played_cards++;
-                card->is_discarding = true;
-                card->is_animating = true;
-                card->target_pos = CP_Vector_Set(
-                    discard_pos.x + (CARD_W_INIT * CARD_SCALE) / 2.0f,
-                    discard_pos.y + (CARD_H_INIT * CARD_SCALE) / 2.0f
-                );
+                SendToDiscard(card);
                 // Reset Selection
                 if (hand_size > 0) selected_card_index = 0;
                 else selected_card_index = -1;
@@ -1428,44 +1396,40 @@ void Game_Update(void) {
 
     // Auto-end turn if less than 3 cards remain and 3 cards have been played
     if (current_phase == PHASE_PLAYER && GetActiveHandSize() < 3 && played_cards == 3) {
+        Replay_Record(&replay_log, REPLAY_END_TURN, 1, 0, 0);
         current_phase = PHASE_ENEMY;
         enemy_action_index = 0;
         enemy_turn_timer = 0.0f;
         selected_card_index = -1;
         // discard all cards in hand on end of turn
         for (int i = 0; i < hand_size; i++) {
-            hand[i].is_discarding = true;
-            hand[i].is_animating = true;
-            hand[i].target_pos = CP_Vector_Set(
-                discard_pos.x + (CARD_W_INIT * CARD_SCALE) / 2.0f,
-                discard_pos.y + (CARD_H_INIT * CARD_SCALE) / 2.0f
-            );
+            SendToDiscard(&hand[i]);
         }
     }
 
     // Developer Mode Logic
+    Profiler_Mark(SECTION_DEVELOPER);
     if (CP_Input_KeyTriggered(KEY_GRAVE_ACCENT)) {
         developer = developer ? 0 : 1;
     }
+    if (developer) CheckHashes();
 
     // Dev Cheat: Spacebar damages selected enemy
-    if (developer && CP_Input_KeyTriggered(KEY_SPACE) && current_enemies && current_enemies[selected_enemy].alive) {
-        current_enemies[selected_enemy].health -= 10;
-        if (current_enemies[selected_enemy].health <= 0) {
-            current_enemies[selected_enemy].alive = false;
+    if (developer && CP_Input_KeyTriggered(KEY_SPACE) && current_enemies && current_enemies->alive[selected_enemy]) {
+        Replay_Record(&replay_log, REPLAY_CHEAT, selected_enemy, 0, 0);
+        current_enemies->health[selected_enemy] -= 10;
+        if (current_enemies->health[selected_enemy] <= 0) {
+            current_enemies->alive[selected_enemy] = 0;
         }
+        Combat_Rehash(&combat);
         enemy_hit_flash[selected_enemy] = 0.2f;
         // Float Text logic for cheat
-        float enemy_width = 120.0f;
-        float spacing = 40.0f;
-        float total_width = (float)current_enemy_count * enemy_width + ((float)current_enemy_count - 1.0f) * spacing;
-        float start_x = ww - total_width - 200.0f;
-        float enemy_x = start_x + (float)selected_enemy * (enemy_width + spacing);
-        float enemy_y = wh / 2.0f - 160.0f / 2.0f;
-        SpawnFloatingText("-10", CP_Vector_Set(enemy_x + 60.0f, enemy_y), CP_Color_Create(255, 255, 0, 255));
+        CP_Vector enemy_pos = EnemyScreenPos(selected_enemy);
+        SpawnFloatingText("-10", CP_Vector_Set(enemy_pos.x + 60.0f, enemy_pos.y), CP_Color_Create(255, 255, 0, 255));
     }
 
     // Deck Recycling Animation
+    Profiler_Mark(SECTION_RECYCLING);
     // Automatically shuffles discard into draw if draw pile is low
     CP_Vector discard_pos_center = CP_Vector_Set(
         discard_pos.x + (CARD_W_INIT * CARD_SCALE) / 2.0f,
@@ -1481,35 +1445,74 @@ void Game_Update(void) {
     if (player_deck.size < 4 && !is_recycling) {
         for (int i = 0; i < discard_size; i++) {
             discard[i].pos = discard_pos_center;
+            discard[i].prev_pos = discard_pos_center;
             discard[i].target_pos = deck_pos_center;
             discard[i].is_animating = true;
         }
         is_recycling = true;
     }
 
-    // if recycling
-    if (is_recycling) {
-        // use custom discard speed and animate the cards and set discard cards to deck
-        for (int i = 0; i < discard_size; i++) {
-            AnimateMoveCard(&discard[i], 300);
-            if (!discard[i].is_animating) {
-                RecycleDeck(discard, &player_deck, &discard_size);
-                is_recycling = false;
-            }
-        }
-        // draw a card to animate the recycle
-        if (discard_size > 0) {
-            DrawCard(&discard[0]);
-        }
+    // if recycling (the cards move in TickAnimations), draw a card to animate the recycle
+    if (is_recycling && discard_size > 0) {
+        Card drawn = discard[0];
+        drawn.pos = GetCardDrawPos(&discard[0], alpha);
+        DrawCard(&drawn, &player);
+    }
+}
+
+// Developer Mode: per-section frame times over the last PROFILER_HISTORY frames, top right
+static void DrawProfilerOverlay(float ww) {
+    ProfilerStat stats[PROFILER_MAX_SECTIONS + 1];
+    int count = Profiler_Stats(stats, PROFILER_MAX_SECTIONS + 1);
+    float row_h = 18.0f, panel_w = 380.0f, x = ww - panel_w - 20.0f, y = 70.0f;
+
+    CP_Settings_NoStroke();
+    CP_Settings_Fill(CP_Color_Create(0, 0, 0, 170));
+    CP_Graphics_DrawRect(x - 10.0f, y - 6.0f, panel_w + 20.0f, row_h * (float)(count + 2) + 12.0f);
+
+    TextStyle style = { game_font, 16.0f, CP_TEXT_ALIGN_H_LEFT, CP_TEXT_ALIGN_V_TOP, CP_Color_Create(200, 200, 200, 255) };
+    char row[96];
+    Text_Begin();
+    snprintf(row, sizeof(row), "Section (ms, %d frames)", Profiler_FrameCount());
+    Text_Draw(&style, row, x, y);
+    style.align_h = CP_TEXT_ALIGN_H_RIGHT;
+    Text_Draw(&style, "last    min    avg    p99", x + panel_w, y);
+
+    for (int i = 0; i < count; i++) {
+        float row_y = y + row_h * (float)(i + 1) + (i == count - 1 ? row_h : 0.0f); // Gap before the frame total
+        style.align_h = CP_TEXT_ALIGN_H_LEFT;
+        style.fill = i == count - 1 ? CP_Color_Create(255, 255, 0, 255) : CP_Color_Create(255, 255, 255, 255);
+        Text_Draw(&style, stats[i].name, x, row_y);
+        snprintf(row, sizeof(row), "%6.2f %6.2f %6.2f %6.2f", stats[i].last_ms, stats[i].min_ms, stats[i].avg_ms, stats[i].p99_ms);
+        style.align_h = CP_TEXT_ALIGN_H_RIGHT;
+        Text_Draw(&style, row, x + panel_w, row_y);
     }
 }
 
-// Cleans up assets when game state exits.
+// Main loop called every frame. Times each step of UpdateFrame; the early returns for stage clear
+// and game over still end the frame here.
+void Game_Update(void) {
+    Profiler_BeginFrame();
+    UpdateFrame();
+    Profiler_Mark(SECTION_PROFILER);
+    if (developer) DrawProfilerOverlay((float)CP_System_GetWindowWidth());
+    Profiler_EndFrame();
+}
+
+// Releases assets when game state exits.
 void Game_Exit(void)
 {
-    CP_Image_Free(game_bg);
-    CP_Sound_Free(background_music);
-    CP_Sound_Free(sfx_shield);
-    CP_Sound_Free(sfx_heal);
-    CP_Sound_Free(sfx_draw);
+    Asset_Release(&game_bg_id);
+    Asset_Release(&background_music_id);
+    Asset_Release(&game_font_id);
+    game_bg = NULL;
+    background_music = NULL;
+    game_font = NULL;
+    Audio_Exit();
+    Ai_Destroy(hint_search);
+    hint_search = NULL;
+    FreeCardFaces();
+    TraceEnemyTurnEnd(); // The player can die mid-turn
+    if (replay_path && replay_log.count > 0 && !Replay_Save(&replay_log, replay_path)) printf("WARNING: Failed to write replay %s\n", replay_path);
+    Trace_AsyncEnd(TRACE_CAT_STATE, "Game", TRACE_ID_SCREEN);
 }
\ No newline at end of file
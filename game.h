@@ -2,32 +2,8 @@
 #pragma once
 #include "cprocessing.h"
 #include <stdbool.h> 
-
-// Represents the player's stats, buffs, and progress.
-typedef struct Player {
-    int health;
-    int max_health;
-    int attack;
-    int shield;
-
-    // --- Player Buffs ---
-    bool has_lifesteal;
-    bool has_desperate_draw;
-    bool has_divine_strike;
-    bool has_shield_boost;
-    bool has_attack_boost_35;
-    bool has_heal_boost_35;
-    bool has_shield_boost_35;
-
-    int checkpoint_level;
-    int death_count;
-
-    // --- Card Bonus Trackers ---
-    int attack_bonus;
-    int heal_bonus;
-    int shield_bonus;
-    int card_reward_count;
-} Player;
+#include <stdint.h>
+#include "player.h"
 
 #define MAX_FLOATING_TEXTS 20
 typedef struct {
@@ -58,6 +34,19 @@ void Game_Increment_Death_Count(void);
 // Returns the total number of times the player has died this session.
 int Game_Get_Death_Count(void);
 
+// Sets the session seed. The first new game uses it as its run seed; later ones derive their own.
+void Game_SetSeed(uint64_t seed);
+
+// Sets the file every run's replay log is written to when the game screen exits (see replay.h).
+// Nothing is written unless a path is set.
+void Game_SetReplayPath(const char* path);
+
+// Collapses every animation and timer (card moves, enemy lunges, banners) so turns resolve at once.
+void Game_SetInstant(bool instant);
+
+// Queues the game screen's images, sounds and font for the asset preloader. Called by the intro.
+void Game_Preload(void);
+
 // CProcessing State Functions
 void Game_Init(void);
 void Game_Update(void);
@@ -3,18 +3,23 @@
 #include <stdio.h>
 #include "game.h" 
 #include "utils.h" 
+#include "assets.h"
+#include "trace.h"
 
 // Use a specific name to avoid conflicts with other files
 static CP_Font gameover_font;
+static AssetId gameover_font_id = ASSET_NONE;
 static float go_timer = 0.0f;
 
 // Loads resources and resets the timer for the Game Over screen.
 void GameOver_Init(void) {
+    Trace_AsyncBegin(TRACE_CAT_STATE, "Game Over", TRACE_ID_SCREEN);
     // 1. Reset Timer
     go_timer = 0.0f;
 
     // 2. Load Font
-    gameover_font = CP_Font_Load("Assets/Exo2-Regular.ttf");
+    gameover_font_id = Asset_Acquire(ASSET_FONT, "Assets/Exo2-Regular.ttf");
+    gameover_font = Asset_Font(gameover_font_id);
 
     // Error Check: If font fails, print to console
     if (gameover_font == 0) {
@@ -91,10 +96,10 @@ void GameOver_Update(void) {
     }
 }
 
-// Frees the font resource for the Game Over screen.
+// Releases the font resource for the Game Over screen.
 void GameOver_Exit(void) {
     // Cleanup
-    if (gameover_font) {
-        CP_Font_Free(gameover_font);
-    }
+    Asset_Release(&gameover_font_id);
+    gameover_font = NULL;
+    Trace_AsyncEnd(TRACE_CAT_STATE, "Game Over", TRACE_ID_SCREEN);
 }
\ No newline at end of file
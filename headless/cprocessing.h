@@ -0,0 +1,128 @@
+// Headless stand-in for the CProcessing header: the part of the CP_* API the game uses, with the
+// same names and signatures, backed by cprocessing_headless.c instead of the Windows engine.
+// Nothing is drawn and no sound plays; state changes, timing, input and asset lookups behave like
+// the engine, so every screen runs as it would. Build the whole game on Linux with
+//   gcc -O2 -std=c11 -Iheadless -pthread -o hexhand_headless $(ls *.c | grep -v -e sim.c -e bench.c -e shop.c) headless/cprocessing_headless.c -lm
+// and drive it with environment variables:
+//   CP_HEADLESS_FRAMES=N    stop after N frames (default 3600; 0 runs until CP_Engine_Terminate)
+//   CP_HEADLESS_DT=S        seconds per frame reported by CP_System_GetDt (default 1/60)
+//   CP_HEADLESS_STUB_ASSETS=1  missing images, fonts and sounds load as placeholders (for checkouts without assets)
+//   CP_HEADLESS_INPUT=FILE  scripted input, one "<frame> <event> [args]" per line ('#' comments):
+//                             key NAME    the key (SPACE, ENTER, ESCAPE, LEFT, RIGHT, GRAVE_ACCENT, A-Z, 0-9) triggers
+//                             click X Y   the mouse moves to (X, Y) and clicks
+//                             mouse X Y   the mouse moves to (X, Y)
+//                             quit        the engine stops after this frame
+// A summary (frames, wall time, frames per second, draw calls) is printed when the engine stops.
+#pragma once
+#include <stdbool.h>
+#include <stddef.h>
+
+typedef int CP_BOOL;
+typedef void (*FunctionPtr)(void);
+
+typedef struct { float x, y; } CP_Vector;
+typedef struct { unsigned char r, g, b, a; } CP_Color;
+
+typedef struct CP_Image_Struct* CP_Image;
+typedef struct CP_Sound_Struct* CP_Sound;
+typedef struct CP_Font_Struct* CP_Font;
+
+typedef enum { CP_POSITION_CENTER, CP_POSITION_CORNER } CP_POSITION_MODE;
+
+typedef enum {
+    CP_TEXT_ALIGN_H_LEFT = 1,
+    CP_TEXT_ALIGN_H_CENTER = 2,
+    CP_TEXT_ALIGN_H_RIGHT = 4
+} CP_TEXT_ALIGN_HORIZONTAL;
+
+typedef enum {
+    CP_TEXT_ALIGN_V_TOP = 8,
+    CP_TEXT_ALIGN_V_MIDDLE = 16,
+    CP_TEXT_ALIGN_V_BOTTOM = 32,
+    CP_TEXT_ALIGN_V_BASELINE = 64
+} CP_TEXT_ALIGN_VERTICAL;
+
+// Key codes follow GLFW, like the engine's.
+typedef enum {
+    KEY_SPACE = 32,
+    KEY_0 = 48, KEY_1, KEY_2, KEY_3, KEY_4, KEY_5, KEY_6, KEY_7, KEY_8, KEY_9,
+    KEY_A = 65, KEY_B, KEY_C, KEY_D, KEY_E, KEY_F, KEY_G, KEY_H, KEY_I, KEY_J, KEY_K, KEY_L, KEY_M,
+    KEY_N, KEY_O, KEY_P, KEY_Q, KEY_R, KEY_S, KEY_T, KEY_U, KEY_V, KEY_W, KEY_X, KEY_Y, KEY_Z,
+    KEY_GRAVE_ACCENT = 96,
+    KEY_ESCAPE = 256,
+    KEY_ENTER = 257,
+    KEY_TAB = 258,
+    KEY_BACKSPACE = 259,
+    KEY_RIGHT = 262,
+    KEY_LEFT = 263,
+    KEY_DOWN = 264,
+    KEY_UP = 265,
+    KEY_LAST = 348
+} CP_KEY;
+
+// --- Engine ---
+void CP_Engine_SetNextGameState(FunctionPtr init, FunctionPtr update, FunctionPtr exit);
+void CP_Engine_Run(int fps);
+void CP_Engine_Terminate(void);
+
+// --- System ---
+void CP_System_SetWindowSize(int width, int height);
+int CP_System_GetWindowWidth(void);
+int CP_System_GetWindowHeight(void);
+float CP_System_GetDt(void);
+
+// --- Color, vectors and math ---
+CP_Color CP_Color_Create(int r, int g, int b, int a);
+CP_Vector CP_Vector_Set(float x, float y);
+CP_Vector CP_Vector_Add(CP_Vector a, CP_Vector b);
+CP_Vector CP_Vector_Subtract(CP_Vector a, CP_Vector b);
+CP_Vector CP_Vector_Scale(CP_Vector a, float scale);
+CP_Vector CP_Vector_Normalize(CP_Vector a);
+float CP_Vector_Length(CP_Vector a);
+float CP_Math_ClampFloat(float value, float min, float max);
+void CP_Random_Seed(int seed);
+
+// --- Settings ---
+void CP_Settings_Fill(CP_Color color);
+void CP_Settings_Stroke(CP_Color color);
+void CP_Settings_NoStroke(void);
+void CP_Settings_StrokeWeight(float weight);
+void CP_Settings_RectMode(CP_POSITION_MODE mode);
+void CP_Settings_TextSize(float size);
+void CP_Settings_TextAlignment(CP_TEXT_ALIGN_HORIZONTAL h, CP_TEXT_ALIGN_VERTICAL v);
+
+// --- Graphics ---
+void CP_Graphics_ClearBackground(CP_Color color);
+void CP_Graphics_DrawRect(float x, float y, float w, float h);
+void CP_Graphics_DrawLine(float x1, float y1, float x2, float y2);
+void CP_Graphics_DrawTriangle(float x1, float y1, float x2, float y2, float x3, float y3);
+
+// --- Images ---
+CP_Image CP_Image_Load(const char* path);
+void CP_Image_Free(CP_Image image);
+int CP_Image_GetWidth(CP_Image image);
+int CP_Image_GetHeight(CP_Image image);
+void CP_Image_Draw(CP_Image image, float x, float y, float w, float h, int alpha);
+void CP_Image_DrawSubImage(CP_Image image, float x, float y, float w, float h,
+    float s0, float t0, float s1, float t1, int alpha);
+CP_Image CP_Image_Screenshot(int x, int y, int w, int h);
+
+// --- Fonts ---
+CP_Font CP_Font_Load(const char* path);
+void CP_Font_Free(CP_Font font);
+void CP_Font_Set(CP_Font font);
+void CP_Font_DrawText(const char* text, float x, float y);
+void CP_Font_DrawTextBox(const char* text, float x, float y, float row_width);
+
+// --- Sound ---
+CP_Sound CP_Sound_Load(const char* path);
+CP_Sound CP_Sound_LoadMusic(const char* path);
+void CP_Sound_Free(CP_Sound sound);
+void CP_Sound_Play(CP_Sound sound);
+void CP_Sound_PlayMusic(CP_Sound sound);
+
+// --- Input ---
+CP_BOOL CP_Input_KeyTriggered(CP_KEY key);
+CP_BOOL CP_Input_MouseClicked(void);
+float CP_Input_GetMouseX(void);
+float CP_Input_GetMouseY(void);
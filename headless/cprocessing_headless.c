@@ -0,0 +1,356 @@
+// @file cprocessing_headless.c
+// @brief Null backend for headless/cprocessing.h: state machine, fixed frame clock, scripted input,
+// asset handles backed by the real files, and draw counters instead of a renderer.
+
+#if !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "cprocessing.h"
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define HEADLESS_DEFAULT_FRAMES 3600
+#define HEADLESS_MAX_EVENTS 4096
+#define HEADLESS_LINE_MAX 128
+#define HEADLESS_STUB_IMAGE_SIZE 64 // Size of the placeholder for a missing image
+
+struct CP_Image_Struct {
+    int width;
+    int height;
+};
+
+struct CP_Sound_Struct {
+    int music;
+};
+
+struct CP_Font_Struct {
+    int unused;
+};
+
+typedef enum {
+    EVENT_KEY,
+    EVENT_CLICK,
+    EVENT_MOUSE,
+    EVENT_QUIT
+} EventType;
+
+typedef struct {
+    long frame;
+    EventType type;
+    int key;
+    float x, y;
+} InputEvent;
+
+// --- Engine state ---
+static FunctionPtr current_init, current_update, current_exit;
+static FunctionPtr next_init, next_update, next_exit;
+static bool has_next_state = false;
+static bool terminate_requested = false;
+static long frame_index = 0;
+static float frame_dt = 1.0f / 60.0f;
+static int window_width = 1280;
+static int window_height = 720;
+static bool stub_assets = false; // Missing files load as placeholders instead of failing
+
+// --- Input ---
+static InputEvent events[HEADLESS_MAX_EVENTS];
+static int event_count = 0;
+static int event_next = 0;
+static bool key_triggered[KEY_LAST + 1];
+static bool mouse_clicked = false;
+static float mouse_x = 0.0f, mouse_y = 0.0f;
+
+// --- Counters ---
+static long long draw_calls = 0;
+static long long text_draws = 0;
+static long long state_changes = 0;
+static int live_images = 0;
+
+// --- Engine ---
+
+void CP_Engine_SetNextGameState(FunctionPtr init, FunctionPtr update, FunctionPtr exit) {
+    next_init = init;
+    next_update = update;
+    next_exit = exit;
+    has_next_state = true;
+}
+
+void CP_Engine_Terminate(void) {
+    terminate_requested = true;
+}
+
+static const struct {
+    const char* name;
+    int key;
+} key_names[] = {
+    { "SPACE", KEY_SPACE }, { "ENTER", KEY_ENTER }, { "ESCAPE", KEY_ESCAPE }, { "TAB", KEY_TAB },
+    { "BACKSPACE", KEY_BACKSPACE }, { "LEFT", KEY_LEFT }, { "RIGHT", KEY_RIGHT }, { "UP", KEY_UP },
+    { "DOWN", KEY_DOWN }, { "GRAVE_ACCENT", KEY_GRAVE_ACCENT },
+};
+
+static int ParseKey(const char* name) {
+    if (name[0] && !name[1]) {
+        if (name[0] >= 'A' && name[0] <= 'Z') return KEY_A + (name[0] - 'A');
+        if (name[0] >= 'a' && name[0] <= 'z') return KEY_A + (name[0] - 'a');
+        if (name[0] >= '0' && name[0] <= '9') return KEY_0 + (name[0] - '0');
+    }
+    for (size_t i = 0; i < sizeof(key_names) / sizeof(key_names[0]); i++) {
+        if (strcmp(key_names[i].name, name) == 0) return key_names[i].key;
+    }
+    return -1;
+}
+
+// Reads the input script. Events must be in frame order; anything malformed is reported and skipped.
+static void LoadInputScript(const char* path) {
+    FILE* file = fopen(path, "r");
+    if (!file) {
+        printf("headless: can't open input script %s\n", path);
+        return;
+    }
+    char line[HEADLESS_LINE_MAX];
+    int line_number = 0;
+    while (fgets(line, sizeof(line), file) && event_count < HEADLESS_MAX_EVENTS) {
+        line_number++;
+        char* comment = strchr(line, '#');
+        if (comment) *comment = '\0';
+
+        InputEvent event;
+        memset(&event, 0, sizeof(event));
+        char verb[16] = "";
+        char arg[32] = "";
+        int fields = sscanf(line, "%ld %15s %31s %f", &event.frame, verb, arg, &event.y);
+        if (fields <= 0) continue;
+
+        bool ok = fields >= 2;
+        if (ok && strcmp(verb, "key") == 0) {
+            event.type = EVENT_KEY;
+            event.key = fields >= 3 ? ParseKey(arg) : -1;
+            ok = event.key >= 0;
+        }
+        else if (ok && (strcmp(verb, "click") == 0 || strcmp(verb, "mouse") == 0)) {
+            event.type = verb[0] == 'c' ? EVENT_CLICK : EVENT_MOUSE;
+            event.x = (float)atof(arg);
+            ok = fields == 4;
+        }
+        else if (ok && strcmp(verb, "quit") == 0) {
+            event.type = EVENT_QUIT;
+        }
+        else ok = false;
+
+        if (!ok || (event_count > 0 && event.frame < events[event_count - 1].frame)) {
+            printf("headless: %s:%d: bad input event\n", path, line_number);
+            continue;
+        }
+        events[event_count++] = event;
+    }
+    fclose(file);
+}
+
+// Applies this frame's scripted events.
+static void PollInput(void) {
+    memset(key_triggered, 0, sizeof(key_triggered));
+    mouse_clicked = false;
+    while (event_next < event_count && events[event_next].frame <= frame_index) {
+        const InputEvent* event = &events[event_next++];
+        if (event->frame < frame_index) continue;
+        switch (event->type) {
+        case EVENT_KEY: key_triggered[event->key] = true; break;
+        case EVENT_CLICK: mouse_clicked = true; /* fall through */
+        case EVENT_MOUSE: mouse_x = event->x; mouse_y = event->y; break;
+        case EVENT_QUIT: terminate_requested = true; break;
+        }
+    }
+}
+
+static double WallSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+void CP_Engine_Run(int fps) {
+    const char* frames_env = getenv("CP_HEADLESS_FRAMES");
+    const char* dt_env = getenv("CP_HEADLESS_DT");
+    const char* input_env = getenv("CP_HEADLESS_INPUT");
+    const char* stub_env = getenv("CP_HEADLESS_STUB_ASSETS");
+    stub_assets = stub_env && strcmp(stub_env, "0") != 0;
+    long max_frames = frames_env ? atol(frames_env) : HEADLESS_DEFAULT_FRAMES;
+    frame_dt = dt_env ? (float)atof(dt_env) : (fps > 0 ? 1.0f / (float)fps : 1.0f / 60.0f);
+    if (input_env) LoadInputScript(input_env);
+
+    double start = WallSeconds();
+    while (!terminate_requested && (max_frames <= 0 || frame_index < max_frames)) {
+        // State changes take effect between frames, like in the engine
+        if (has_next_state) {
+            has_next_state = false;
+            if (current_exit) current_exit();
+            current_init = next_init;
+            current_update = next_update;
+            current_exit = next_exit;
+            if (current_init) current_init();
+        }
+        PollInput();
+        if (current_update) current_update();
+        frame_index++;
+    }
+    if (current_exit) current_exit();
+    double elapsed = WallSeconds() - start;
+
+    printf("headless: %ld frames in %.3f s (%.0f fps), %lld draw calls, %lld text draws, %lld state changes, %d images alive\n",
+        frame_index, elapsed, elapsed > 0.0 ? (double)frame_index / elapsed : 0.0,
+        draw_calls, text_draws, state_changes, live_images);
+}
+
+// --- System ---
+
+void CP_System_SetWindowSize(int width, int height) {
+    window_width = width;
+    window_height = height;
+}
+
+int CP_System_GetWindowWidth(void) { return window_width; }
+int CP_System_GetWindowHeight(void) { return window_height; }
+float CP_System_GetDt(void) { return frame_dt; }
+
+// --- Color, vectors and math ---
+
+static int ClampByte(int v) { return v < 0 ? 0 : (v > 255 ? 255 : v); }
+
+CP_Color CP_Color_Create(int r, int g, int b, int a) {
+    CP_Color color = { (unsigned char)ClampByte(r), (unsigned char)ClampByte(g), (unsigned char)ClampByte(b), (unsigned char)ClampByte(a) };
+    return color;
+}
+
+CP_Vector CP_Vector_Set(float x, float y) { CP_Vector v = { x, y }; return v; }
+CP_Vector CP_Vector_Add(CP_Vector a, CP_Vector b) { return CP_Vector_Set(a.x + b.x, a.y + b.y); }
+CP_Vector CP_Vector_Subtract(CP_Vector a, CP_Vector b) { return CP_Vector_Set(a.x - b.x, a.y - b.y); }
+CP_Vector CP_Vector_Scale(CP_Vector a, float scale) { return CP_Vector_Set(a.x * scale, a.y * scale); }
+float CP_Vector_Length(CP_Vector a) { return sqrtf(a.x * a.x + a.y * a.y); }
+
+CP_Vector CP_Vector_Normalize(CP_Vector a) {
+    float length = CP_Vector_Length(a);
+    return length > 0.0f ? CP_Vector_Scale(a, 1.0f / length) : CP_Vector_Set(0.0f, 0.0f);
+}
+
+float CP_Math_ClampFloat(float value, float min, float max) {
+    return value < min ? min : (value > max ? max : value);
+}
+
+void CP_Random_Seed(int seed) { (void)seed; } // The game draws from its own rng.h streams
+
+// --- Settings: accepted and counted, nothing to apply ---
+
+void CP_Settings_Fill(CP_Color color) { (void)color; state_changes++; }
+void CP_Settings_Stroke(CP_Color color) { (void)color; state_changes++; }
+void CP_Settings_NoStroke(void) { state_changes++; }
+void CP_Settings_StrokeWeight(float weight) { (void)weight; state_changes++; }
+void CP_Settings_RectMode(CP_POSITION_MODE mode) { (void)mode; state_changes++; }
+void CP_Settings_TextSize(float size) { (void)size; state_changes++; }
+void CP_Settings_TextAlignment(CP_TEXT_ALIGN_HORIZONTAL h, CP_TEXT_ALIGN_VERTICAL v) { (void)h; (void)v; state_changes++; }
+
+// --- Graphics ---
+
+void CP_Graphics_ClearBackground(CP_Color color) { (void)color; draw_calls++; }
+void CP_Graphics_DrawRect(float x, float y, float w, float h) { (void)x; (void)y; (void)w; (void)h; draw_calls++; }
+void CP_Graphics_DrawLine(float x1, float y1, float x2, float y2) { (void)x1; (void)y1; (void)x2; (void)y2; draw_calls++; }
+
+void CP_Graphics_DrawTriangle(float x1, float y1, float x2, float y2, float x3, float y3) {
+    (void)x1; (void)y1; (void)x2; (void)y2; (void)x3; (void)y3;
+    draw_calls++;
+}
+
+// --- Images: sized from the PNG header so layout code sees real dimensions ---
+
+static uint32_t ReadBigEndian32(const unsigned char* in) {
+    return ((uint32_t)in[0] << 24) | ((uint32_t)in[1] << 16) | ((uint32_t)in[2] << 8) | (uint32_t)in[3];
+}
+
+static CP_Image NewImage(int width, int height) {
+    CP_Image image = malloc(sizeof(*image));
+    if (!image) return NULL;
+    image->width = width;
+    image->height = height;
+    live_images++;
+    return image;
+}
+
+CP_Image CP_Image_Load(const char* path) {
+    FILE* file = path ? fopen(path, "rb") : NULL;
+    if (!file) return stub_assets ? NewImage(HEADLESS_STUB_IMAGE_SIZE, HEADLESS_STUB_IMAGE_SIZE) : NULL;
+    unsigned char header[24];
+    size_t got = fread(header, 1, sizeof(header), file);
+    fclose(file);
+    bool png = got == sizeof(header) && memcmp(header, "\x89PNG\r\n\x1a\n", 8) == 0;
+    return NewImage(png ? (int)ReadBigEndian32(header + 16) : 0, png ? (int)ReadBigEndian32(header + 20) : 0);
+}
+
+void CP_Image_Free(CP_Image image) {
+    if (!image) return;
+    free(image);
+    live_images--;
+}
+
+int CP_Image_GetWidth(CP_Image image) { return image ? image->width : 0; }
+int CP_Image_GetHeight(CP_Image image) { return image ? image->height : 0; }
+
+void CP_Image_Draw(CP_Image image, float x, float y, float w, float h, int alpha) {
+    (void)image; (void)x; (void)y; (void)w; (void)h; (void)alpha;
+    draw_calls++;
+}
+
+void CP_Image_DrawSubImage(CP_Image image, float x, float y, float w, float h,
+    float s0, float t0, float s1, float t1, int alpha) {
+    (void)image; (void)x; (void)y; (void)w; (void)h; (void)s0; (void)t0; (void)s1; (void)t1; (void)alpha;
+    draw_calls++;
+}
+
+CP_Image CP_Image_Screenshot(int x, int y, int w, int h) {
+    (void)x; (void)y;
+    return NewImage(w, h);
+}
+
+// --- Fonts and sounds: a handle if the file exists (or assets are stubbed), NULL otherwise ---
+
+static bool FileExists(const char* path) {
+    FILE* file = path ? fopen(path, "rb") : NULL;
+    if (!file) return stub_assets;
+    fclose(file);
+    return true;
+}
+
+CP_Font CP_Font_Load(const char* path) {
+    return FileExists(path) ? calloc(1, sizeof(struct CP_Font_Struct)) : NULL;
+}
+
+void CP_Font_Free(CP_Font font) { free(font); }
+void CP_Font_Set(CP_Font font) { (void)font; state_changes++; }
+void CP_Font_DrawText(const char* text, float x, float y) { (void)text; (void)x; (void)y; text_draws++; }
+void CP_Font_DrawTextBox(const char* text, float x, float y, float row_width) { (void)text; (void)x; (void)y; (void)row_width; text_draws++; }
+
+static CP_Sound LoadSound(const char* path, int music) {
+    if (!FileExists(path)) return NULL;
+    CP_Sound sound = calloc(1, sizeof(*sound));
+    if (sound) sound->music = music;
+    return sound;
+}
+
+CP_Sound CP_Sound_Load(const char* path) { return LoadSound(path, 0); }
+CP_Sound CP_Sound_LoadMusic(const char* path) { return LoadSound(path, 1); }
+void CP_Sound_Free(CP_Sound sound) { free(sound); }
+void CP_Sound_Play(CP_Sound sound) { (void)sound; }
+void CP_Sound_PlayMusic(CP_Sound sound) { (void)sound; }
+
+// --- Input ---
+
+CP_BOOL CP_Input_KeyTriggered(CP_KEY key) {
+    return (key >= 0 && key <= KEY_LAST) ? key_triggered[key] : 0;
+}
+
+CP_BOOL CP_Input_MouseClicked(void) { return mouse_clicked; }
+float CP_Input_GetMouseX(void) { return mouse_x; }
+float CP_Input_GetMouseY(void) { return mouse_y; }
@@ -1,6 +1,9 @@
 #include "cprocessing.h"
 #include "intro.h"
 #include "mainmenu.h"
+#include "game.h"
+#include "assets.h"
+#include "trace.h"
 #include <stdio.h>
 
 // --- Configuration ---
@@ -8,6 +11,9 @@
 #define HOLD_DURATION 2.0f    // How long to stay fully visible
 
 // --- Assets ---
+static AssetId logo_digipen_id = ASSET_NONE;
+static AssetId logo_game_id = ASSET_NONE;
+static AssetId copyright_font_id = ASSET_NONE;
 static CP_Image logo_digipen = NULL;
 static CP_Image logo_game = NULL;
 static CP_Font copyright_font = NULL;
@@ -19,12 +25,19 @@ static int current_phase = 0; // 0 = Fade In DP, 1 = Hold DP, 2 = Fade Out DP, 3
 
 void Intro_Init(void)
 {
+    Trace_AsyncBegin(TRACE_CAT_STATE, "Intro", TRACE_ID_SCREEN);
     // Load Assets
     // Make sure these files exist in your Assets folder!
-    logo_digipen = CP_Image_Load("Assets/DigiPen_Logo.png");
-    logo_game = CP_Image_Load("Assets/HexHand_Logo.png"); // Your game logo
+    logo_digipen_id = Asset_Acquire(ASSET_IMAGE, "Assets/DigiPen_Logo.png");
+    logo_game_id = Asset_Acquire(ASSET_IMAGE, "Assets/HexHand_Logo.png"); // Your game logo
+    copyright_font_id = Asset_Acquire(ASSET_FONT, "Assets/Exo2-Regular.ttf"); // Using same font as game
+    logo_digipen = Asset_Image(logo_digipen_id);
+    logo_game = Asset_Image(logo_game_id);
+    copyright_font = Asset_Font(copyright_font_id);
 
-    copyright_font = CP_Font_Load("Assets/Exo2-Regular.ttf"); // Using same font as game
+    // Read the game's assets from disk in the background while the logos play
+    Game_Preload();
+    Asset_StartPreload();
 
     // Reset State
     alpha = 0.0f;
@@ -40,6 +53,9 @@ void Intro_Update(void)
     float width = (float)CP_System_GetWindowWidth();
     float height = (float)CP_System_GetWindowHeight();
 
+    // Finish a few preloaded assets each frame
+    Asset_Pump(ASSET_PUMP_BUDGET);
+
     // Always Black Background
     CP_Graphics_ClearBackground(CP_Color_Create(0, 0, 0, 255));
 
@@ -151,6 +167,11 @@ void Intro_Update(void)
 void Intro_Exit(void)
 {
     // Clean up assets
-    CP_Image_Free(logo_digipen);
-    CP_Image_Free(logo_game);
+    Asset_Release(&logo_digipen_id);
+    Asset_Release(&logo_game_id);
+    Asset_Release(&copyright_font_id);
+    logo_digipen = NULL;
+    logo_game = NULL;
+    copyright_font = NULL;
+    Trace_AsyncEnd(TRACE_CAT_STATE, "Intro", TRACE_ID_SCREEN);
 }
\ No newline at end of file
@@ -1,74 +1,420 @@
 #include "levels.h"
+#include "platform.h"
+#include <ctype.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
 // ---------------- Level 1 ----------------
 // Tier 1: Basic
-Enemy level1_enemies[] = {
+static const Enemy level1_enemies[] = {
     { "Goblin", 21, 21, 5, 5, 0, true, 0, false, false, false, 0 },
     { "Slime",  14, 14, 8, 8, 0, true, 0, false, false, false, 0 }
 };
-int level1_enemy_count = sizeof(level1_enemies) / sizeof(level1_enemies[0]);
 
 // ---------------- Level 2 ----------------
-Enemy level2_enemies[] = {
+static const Enemy level2_enemies[] = {
     { "Goblin",   21, 21, 5, 5, 0, true, 0, false, false, false, 0 },
     { "Slime", 14, 14, 8, 8, 0, true, 0, false, false, false, 0 },
     { "Slime", 14, 14, 8, 8, 0, true, 0, false, false, false, 0 }
 };
-int level2_enemy_count = sizeof(level2_enemies) / sizeof(level2_enemies[0]);
 
 // ---------------- Level 3 (Boss 1) ----------------
 // --- MODIFIED: Set enrage to true, enrage_amount to 2 ---
-Enemy level3_enemies[] = {
+static const Enemy level3_enemies[] = {
     { "Witch",   50,  50, 6, 6, 5, true, 0, false, false, true, 2 }, // The Enraging Boss
     { "Orc Grunt",  14,  14, 8, 8, 0, true, 0, false, false, false, 0 },
     { "Goblin",  14,  14, 4, 4, 0, true, 0, false, false, false, 0 }
 };
-int level3_enemy_count = sizeof(level3_enemies) / sizeof(level3_enemies[0]);
 
 // ---------------- Level 4 ----------------
 // Tier 2: Stronger Grunts
-Enemy level4_enemies[] = {
+static const Enemy level4_enemies[] = {
     { "Orc Grunt",    28, 28, 8, 8, 0, true, 0, false, false, false, 0 },
     { "Goblin",       21, 21, 4, 4, 0, true, 0, false, false, false, 0 },
     { "Orc Grunt",    28, 28, 8, 8, 0, true, 0, false, false, false, 0 }
 };
-int level4_enemy_count = sizeof(level4_enemies) / sizeof(level4_enemies[0]);
 
 // ---------------- Level 5 ----------------
-Enemy level5_enemies[] = {
+static const Enemy level5_enemies[] = {
     { "Armored Goblin", 35, 35, 6, 6, 10, true, 0, false, false, false, 0 },
     { "Orc Grunt",      42, 42, 8, 8, 0, true, 0, false, false, false, 0 },
     { "Armored Goblin", 35, 35, 6, 6, 10, true, 0, false, false, false, 0 }
 };
-int level5_enemy_count = sizeof(level5_enemies) / sizeof(level5_enemies[0]);
 
 // ---------------- Level 6 (Boss 2) ----------------
 // --- MODIFIED: Reduced health from 300 to 220 ---
-Enemy level6_enemies[] = {
+static const Enemy level6_enemies[] = {
     { "OGRE WARLORD", 140, 140, 11, 11, 10, true, 0, false, false, true, 3 }
 };
-int level6_enemy_count = sizeof(level6_enemies) / sizeof(level6_enemies[0]);
 
 // ---------------- Level 7 ----------------
 // Tier 3: Elite Enemies
-Enemy level7_enemies[] = {
+static const Enemy level7_enemies[] = {
     { "Shadow Stalker", 40, 40, 8, 8, 5, true, 0, false, false, false, 0 },
     { "Orc Shaman",     30, 30, 6, 6, 10, true, 0, false, false, false, 0 },
     { "Shadow Stalker", 40, 40, 8, 8, 5, true, 0, false, false, false, 0 }
 };
-int level7_enemy_count = sizeof(level7_enemies) / sizeof(level7_enemies[0]);
 
 // ---------------- Level 8 ----------------
-Enemy level8_enemies[] = {
+static const Enemy level8_enemies[] = {
     { "Ogre",           40, 40, 8, 8, 0, true, 0, false, false, false, 0 },
     { "Armored Orc",    60, 60, 14, 14, 20, true, 0, false, false, false, 0 },
     { "Ogre",           40, 40, 8, 8, 0, true, 0, false, false, false, 0 }
 };
-int level8_enemy_count = sizeof(level8_enemies) / sizeof(level8_enemies[0]);
 
 // ---------------- Level 9 (Boss 3) ----------------
 // --- MODIFIED: Set enrage to true, enrage_amount to 4 ---
-Enemy level9_enemies[] = {
+static const Enemy level9_enemies[] = {
     { "LICH LORD", 250, 250, 16, 16, 15, true, 0, true, false, true, 4 } // Lich is Necro AND Enrages
 };
-int level9_enemy_count = sizeof(level9_enemies) / sizeof(level9_enemies[0]);
\ No newline at end of file
+
+// ---------------- Level table ----------------
+#define LEVEL_ENTRY(arr) { arr, (int)(sizeof(arr) / sizeof(arr[0])) }
+
+static const LevelDef builtin_levels[] = {
+    LEVEL_ENTRY(level1_enemies),
+    LEVEL_ENTRY(level2_enemies),
+    LEVEL_ENTRY(level3_enemies),
+    LEVEL_ENTRY(level4_enemies),
+    LEVEL_ENTRY(level5_enemies),
+    LEVEL_ENTRY(level6_enemies),
+    LEVEL_ENTRY(level7_enemies),
+    LEVEL_ENTRY(level8_enemies),
+    LEVEL_ENTRY(level9_enemies)
+};
+
+// Active table: the built-in levels above until Levels_Load succeeds
+static const LevelDef* level_table = builtin_levels;
+static int level_count = (int)(sizeof(builtin_levels) / sizeof(builtin_levels[0]));
+
+// ---------------- Level file ----------------
+// The text file holds one enemy per line:
+//     level,name,health,attack,shield,enrage_amount,necromancer
+// Levels are numbered 1, 2, 3, ... in order; blank lines and lines starting with '#' are skipped.
+// A parsed file is compiled into a binary cache (path + ".bin") that later loads map straight into
+// memory without parsing. The cache is rebuilt whenever the text file's size or write time changes.
+
+#define LEVEL_CACHE_MAGIC 0x4C564C43u // "CLVL"
+#define LEVEL_CACHE_VERSION 1u
+#define LEVEL_CACHE_MAX_COUNT (1u << 20)
+#define LEVEL_FLAG_NECROMANCER 1u
+#define LEVEL_LINE_LENGTH 256
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t source_size;  // Size of the text file the cache was built from
+    int64_t source_mtime;  // Write time of the text file the cache was built from
+    uint32_t level_count;
+    uint32_t enemy_count;
+    uint32_t names_size;   // Bytes of NUL-terminated names after the enemy records
+    uint32_t reserved;
+} LevelCacheHeader;
+
+typedef struct {
+    uint32_t first_enemy;
+    uint32_t enemy_count;
+} LevelCacheLevel;
+
+typedef struct {
+    uint32_t name_offset;
+    int32_t health;
+    int32_t attack;
+    int32_t shield;
+    int32_t enrage_amount; // 0 = doesn't enrage
+    uint32_t flags;
+} LevelCacheEnemy;
+
+static LevelDef* loaded_levels = NULL;      // Level table and enemy templates in one allocation
+static PlatformMappedFile cache_file;       // Backs the loaded enemy names when the cache is mapped
+static unsigned char* cache_blob = NULL;    // Backs them instead when the cache couldn't be mapped
+
+// Drops any loaded level data and goes back to the built-in tables.
+static void ReleaseLoadedLevels(void) {
+    level_table = builtin_levels;
+    level_count = (int)(sizeof(builtin_levels) / sizeof(builtin_levels[0]));
+    free(loaded_levels);
+    loaded_levels = NULL;
+    free(cache_blob);
+    cache_blob = NULL;
+    Platform_UnmapFile(&cache_file);
+}
+
+// Validates a compiled cache and makes it the active level table. Names point into data, so it
+// must stay alive until the next load.
+static bool InstallLevelCache(const unsigned char* data, size_t size) {
+    if (size < sizeof(LevelCacheHeader)) return false;
+    const LevelCacheHeader* header = (const LevelCacheHeader*)data;
+    if (header->magic != LEVEL_CACHE_MAGIC || header->version != LEVEL_CACHE_VERSION) return false;
+    if (header->level_count == 0 || header->level_count > LEVEL_CACHE_MAX_COUNT) return false;
+    if (header->enemy_count == 0 || header->enemy_count > LEVEL_CACHE_MAX_COUNT) return false;
+    if (header->names_size == 0) return false;
+
+    uint64_t expected = sizeof(LevelCacheHeader)
+        + (uint64_t)header->level_count * sizeof(LevelCacheLevel)
+        + (uint64_t)header->enemy_count * sizeof(LevelCacheEnemy)
+        + header->names_size;
+    if (expected != size) return false;
+
+    const LevelCacheLevel* levels = (const LevelCacheLevel*)(data + sizeof(LevelCacheHeader));
+    const LevelCacheEnemy* enemies = (const LevelCacheEnemy*)(levels + header->level_count);
+    const char* names = (const char*)(enemies + header->enemy_count);
+    if (names[header->names_size - 1] != '\0') return false;
+
+    for (uint32_t i = 0; i < header->level_count; i++) {
+        if (levels[i].enemy_count == 0 || levels[i].enemy_count > ENCOUNTER_MAX_ENEMIES) return false;
+        if (levels[i].first_enemy > header->enemy_count - levels[i].enemy_count) return false;
+    }
+    for (uint32_t i = 0; i < header->enemy_count; i++) {
+        if (enemies[i].name_offset >= header->names_size) return false;
+    }
+
+    LevelDef* table = malloc(sizeof(LevelDef) * header->level_count + sizeof(Enemy) * header->enemy_count);
+    if (!table) return false;
+    Enemy* templates = (Enemy*)(table + header->level_count);
+
+    for (uint32_t i = 0; i < header->enemy_count; i++) {
+        const LevelCacheEnemy* src = &enemies[i];
+        Enemy* e = &templates[i];
+        memset(e, 0, sizeof(*e));
+        e->name = names + src->name_offset;
+        e->health = e->max_health = src->health;
+        e->attack = e->max_attack = src->attack;
+        e->shield = src->shield;
+        e->alive = true;
+        e->is_necromancer = (src->flags & LEVEL_FLAG_NECROMANCER) != 0;
+        e->enrages = src->enrage_amount != 0;
+        e->enrage_amount = src->enrage_amount;
+    }
+    for (uint32_t i = 0; i < header->level_count; i++) {
+        table[i].enemies = templates + levels[i].first_enemy;
+        table[i].enemy_count = (int)levels[i].enemy_count;
+    }
+
+    loaded_levels = table;
+    level_table = table;
+    level_count = (int)header->level_count;
+    return true;
+}
+
+// Grows a heap array so it can hold at least needed elements. Returns false when out of memory.
+static bool Reserve(void** items, uint32_t* capacity, uint32_t needed, size_t item_size) {
+    if (needed <= *capacity) return true;
+    uint32_t grown = *capacity ? *capacity * 2 : 16;
+    while (grown < needed) grown *= 2;
+    void* resized = realloc(*items, (size_t)grown * item_size);
+    if (!resized) return false;
+    *items = resized;
+    *capacity = grown;
+    return true;
+}
+
+// Strips leading and trailing whitespace in place.
+static char* Trim(char* s) {
+    while (isspace((unsigned char)*s)) s++;
+    char* end = s + strlen(s);
+    while (end > s && isspace((unsigned char)end[-1])) end--;
+    *end = '\0';
+    return s;
+}
+
+// Splits a line at commas in place. Returns the number of fields.
+static int SplitFields(char* line, char** fields, int max_fields) {
+    int count = 0;
+    char* field = line;
+    while (count < max_fields) {
+        char* comma = strchr(field, ',');
+        if (comma) *comma = '\0';
+        fields[count++] = Trim(field);
+        if (!comma) return count;
+        field = comma + 1;
+    }
+    return max_fields + 1; // Too many fields
+}
+
+static bool ParseInt(const char* s, int min, int max, int32_t* out) {
+    char* end;
+    long value = strtol(s, &end, 10);
+    if (end == s || *end != '\0' || value < min || value > max) return false;
+    *out = (int32_t)value;
+    return true;
+}
+
+// Parses the text file into a cache blob in memory. Returns NULL if the file is missing or malformed.
+static unsigned char* CompileLevelText(const char* path, uint64_t source_size, int64_t source_mtime, size_t* out_size) {
+    FILE* file = fopen(path, "r");
+    if (!file) return NULL;
+
+    LevelCacheLevel* levels = NULL; uint32_t levels_cap = 0;
+    LevelCacheEnemy* enemies = NULL; uint32_t enemies_cap = 0;
+    char* names = NULL; uint32_t names_cap = 0;
+    uint32_t level_total = 0, enemy_total = 0, names_size = 0;
+    unsigned char* blob = NULL;
+    bool ok = true;
+
+    char line[LEVEL_LINE_LENGTH];
+    while (ok && fgets(line, sizeof(line), file)) {
+        char* text = Trim(line);
+        if (text[0] == '\0' || text[0] == '#') continue;
+
+        char* fields[7];
+        int32_t level, health, attack, shield, enrage, necromancer;
+        ok = SplitFields(text, fields, 7) == 7
+            && ParseInt(fields[0], 1, (int)LEVEL_CACHE_MAX_COUNT, &level)
+            && fields[1][0] != '\0'
+            && ParseInt(fields[2], 1, 1000000, &health)
+            && ParseInt(fields[3], 0, 1000000, &attack)
+            && ParseInt(fields[4], 0, 1000000, &shield)
+            && ParseInt(fields[5], 0, 1000000, &enrage)
+            && ParseInt(fields[6], 0, 1, &necromancer);
+        if (!ok) break;
+
+        // A line either continues the current level or starts the next one
+        if ((uint32_t)level == level_total + 1) {
+            ok = Reserve((void**)&levels, &levels_cap, level_total + 1, sizeof(LevelCacheLevel));
+            if (!ok) break;
+            levels[level_total].first_enemy = enemy_total;
+            levels[level_total].enemy_count = 0;
+            level_total++;
+        }
+        else if ((uint32_t)level != level_total) {
+            ok = false;
+            break;
+        }
+        if (levels[level_total - 1].enemy_count >= ENCOUNTER_MAX_ENEMIES) { ok = false; break; }
+
+        uint32_t name_length = (uint32_t)strlen(fields[1]) + 1;
+        ok = Reserve((void**)&enemies, &enemies_cap, enemy_total + 1, sizeof(LevelCacheEnemy))
+            && Reserve((void**)&names, &names_cap, names_size + name_length, 1);
+        if (!ok) break;
+
+        LevelCacheEnemy* e = &enemies[enemy_total++];
+        e->name_offset = names_size;
+        e->health = health;
+        e->attack = attack;
+        e->shield = shield;
+        e->enrage_amount = enrage;
+        e->flags = necromancer ? LEVEL_FLAG_NECROMANCER : 0u;
+        memcpy(names + names_size, fields[1], name_length);
+        names_size += name_length;
+        levels[level_total - 1].enemy_count++;
+    }
+    fclose(file);
+
+    if (ok && level_total > 0) {
+        LevelCacheHeader header = {
+            LEVEL_CACHE_MAGIC, LEVEL_CACHE_VERSION, source_size, source_mtime,
+            level_total, enemy_total, names_size, 0
+        };
+        size_t levels_bytes = sizeof(LevelCacheLevel) * level_total;
+        size_t enemies_bytes = sizeof(LevelCacheEnemy) * enemy_total;
+        *out_size = sizeof(header) + levels_bytes + enemies_bytes + names_size;
+        blob = malloc(*out_size);
+        if (blob) {
+            unsigned char* cursor = blob;
+            memcpy(cursor, &header, sizeof(header)); cursor += sizeof(header);
+            memcpy(cursor, levels, levels_bytes); cursor += levels_bytes;
+            memcpy(cursor, enemies, enemies_bytes); cursor += enemies_bytes;
+            memcpy(cursor, names, names_size);
+        }
+    }
+
+    free(levels);
+    free(enemies);
+    free(names);
+    return blob;
+}
+
+static bool WriteLevelCache(const char* path, const unsigned char* blob, size_t size) {
+    FILE* file = fopen(path, "wb");
+    if (!file) return false;
+    bool ok = fwrite(blob, 1, size, file) == size;
+    ok = (fclose(file) == 0) && ok;
+    if (!ok) remove(path); // Never leave a truncated cache behind
+    return ok;
+}
+
+// Checks that a mapped cache was built from the current text file. With no text file, any cache is used.
+static bool CacheMatchesSource(const PlatformMappedFile* cache, bool has_source, uint64_t size, int64_t mtime) {
+    if (cache->size < sizeof(LevelCacheHeader)) return false;
+    if (!has_source) return true;
+    const LevelCacheHeader* header = (const LevelCacheHeader*)cache->data;
+    return header->source_size == size && header->source_mtime == mtime;
+}
+
+int Levels_Load(const char* path) {
+    ReleaseLoadedLevels();
+    if (!path) return 0;
+
+    char cache_path[260];
+    if (snprintf(cache_path, sizeof(cache_path), "%s.bin", path) >= (int)sizeof(cache_path)) return 0;
+
+    uint64_t source_size = 0;
+    int64_t source_mtime = 0;
+    bool has_source = Platform_FileStamp(path, &source_size, &source_mtime);
+
+    // Fast path: map the compiled cache and use it in place
+    if (Platform_MapFile(cache_path, &cache_file)) {
+        if (CacheMatchesSource(&cache_file, has_source, source_size, source_mtime)
+            && InstallLevelCache((const unsigned char*)cache_file.data, cache_file.size)) {
+            return level_count;
+        }
+        Platform_UnmapFile(&cache_file);
+    }
+    if (!has_source) return 0;
+
+    // Slow path: parse the text, write the cache for next time and load from it
+    size_t blob_size = 0;
+    unsigned char* blob = CompileLevelText(path, source_size, source_mtime, &blob_size);
+    if (!blob) return 0;
+
+    if (WriteLevelCache(cache_path, blob, blob_size) && Platform_MapFile(cache_path, &cache_file)) {
+        if (InstallLevelCache((const unsigned char*)cache_file.data, cache_file.size)) {
+            free(blob);
+            return level_count;
+        }
+        Platform_UnmapFile(&cache_file);
+    }
+    if (InstallLevelCache(blob, blob_size)) {
+        cache_blob = blob;
+        return level_count;
+    }
+    free(blob);
+    return 0;
+}
+
+int Levels_Count(void) {
+    return level_count;
+}
+
+const LevelDef* Levels_Get(int level) {
+    if (level < 1 || level > level_count) return NULL;
+    return &level_table[level - 1];
+}
+
+void Encounter_Load(Encounter* encounter, int level) {
+    if (!encounter) return;
+    const LevelDef* def = Levels_Get(level);
+    if (!def || def->enemy_count <= 0) {
+        level = 1;
+        def = Levels_Get(1);
+    }
+
+    int count = def->enemy_count;
+    if (count > ENCOUNTER_MAX_ENEMIES) count = ENCOUNTER_MAX_ENEMIES;
+    memset(encounter, 0, sizeof(*encounter));
+    encounter->level = level;
+    encounter->enemy_count = count;
+    for (int i = 0; i < count; i++) {
+        const Enemy* e = &def->enemies[i];
+        // Every fight starts at full health with no shield, like the old reset pass in LoadLevel
+        encounter->templates[i] = e;
+        encounter->health[i] = e->max_health;
+        encounter->shield[i] = 0;
+        encounter->attack[i] = e->enrages ? e->max_attack : e->attack;
+        encounter->alive[i] = 1;
+    }
+}
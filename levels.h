@@ -1,6 +1,7 @@
 // Enemy definitions and configuration data.
 #pragma once
 #include <stdbool.h>
+#include <stdint.h>
 
 #ifndef _level_H
 #define _level_H
@@ -21,42 +22,37 @@ typedef struct { // Represents a single enemy unit with stats and flags.
     int enrage_amount; // Added to determine enrage amount
 } Enemy;
 
-// Extern declarations for enemy arrays per level
-// ---------------- Level 1 ----------------
-extern Enemy level1_enemies[];
-extern int level1_enemy_count;
-
-// ---------------- Level 2 ----------------
-extern Enemy level2_enemies[];
-extern int level2_enemy_count;
-
-// --- NEW: Levels 3-9 ---
-// ---------------- Level 3 (Boss) ----------------
-extern Enemy level3_enemies[];
-extern int level3_enemy_count;
-
-// ---------------- Level 4 ----------------
-extern Enemy level4_enemies[];
-extern int level4_enemy_count;
-
-// ---------------- Level 5 ----------------
-extern Enemy level5_enemies[];
-extern int level5_enemy_count;
-
-// ---------------- Level 6 (Boss) ----------------
-extern Enemy level6_enemies[];
-extern int level6_enemy_count;
-
-// ---------------- Level 7 ----------------
-extern Enemy level7_enemies[];
-extern int level7_enemy_count;
-
-// ---------------- Level 8 ----------------
-extern Enemy level8_enemies[];
-extern int level8_enemy_count;
-
-// ---------------- Level 9 (Boss) ----------------
-extern Enemy level9_enemies[];
-extern int level9_enemy_count;
+// ---------------- Level table ----------------
+#define ENCOUNTER_MAX_ENEMIES 8
+
+typedef struct { // Immutable enemy lineup for one level. Never modified during a fight.
+    const Enemy* enemies;
+    int enemy_count;
+} LevelDef;
+
+typedef struct { // Per-fight enemy instances, filled from a LevelDef when the level starts.
+    // Mutable stats in structure-of-arrays form so AOE effects can update every enemy at once
+    int32_t health[ENCOUNTER_MAX_ENEMIES];
+    int32_t shield[ENCOUNTER_MAX_ENEMIES];
+    int32_t attack[ENCOUNTER_MAX_ENEMIES];
+    int32_t alive[ENCOUNTER_MAX_ENEMIES]; // 1 = alive, 0 = dead or unused slot
+    const Enemy* templates[ENCOUNTER_MAX_ENEMIES]; // Name, max stats and enrage data
+    int enemy_count;
+    int level;
+} Encounter;
+
+// Loads the level table from a text file, using or rebuilding its compiled cache (path + ".bin").
+// Returns the number of levels loaded, or 0 if the file couldn't be used and the built-in levels
+// stay active. Call before any encounter is loaded or any thread reads the templates.
+int Levels_Load(const char* path);
+
+// Returns the number of levels in the active table.
+int Levels_Count(void);
+
+// Returns the template for a level (1-based), or NULL if it doesn't exist.
+const LevelDef* Levels_Get(int level);
+
+// Fills the encounter with fresh instances of the level's enemies. Unknown levels fall back to level 1.
+void Encounter_Load(Encounter* encounter, int level);
 
 #endif
\ No newline at end of file
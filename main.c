@@ -1,32 +1,57 @@
 // Entry point for the application.
 #include "cprocessing.h"
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include <time.h>
 #include "mainmenu.h"
 #include "card.h"
+#include "levels.h"
 #include "intro.h"
+#include "game.h"
+#include "assets.h"
+#include "trace.h"
 
-// Main execution function. Sets up the window, seeds RNG, loads static data (catalogue),
+// Main execution function. Sets up the window, picks the session seed, loads static data (catalogue),
 // and starts the CProcessing engine with the Intro state. Returns 0 on success.
-int main(void)
+// Pass --seed N to replay a run (the seed is printed whenever a new game starts), and --record FILE
+// to write the run's replay log to FILE (off by default; play it back with sim --replay).
+// --instant skips every animation. --trace FILE records a Chrome trace timeline of screens, asset loads,
+// enemy turns and frame sections, written to FILE on exit.
+int main(int argc, char* argv[])
 {
-    // Seed the random number generator
-    CP_Random_Seed((unsigned int)time(NULL));
+    // Session seed for the game's Rng streams (rng.h): clock by default, or --seed from the command line
+    uint64_t seed = (uint64_t)time(NULL);
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) seed = strtoull(argv[++i], NULL, 10);
+        else if (strcmp(argv[i], "--record") == 0 && i + 1 < argc) Game_SetReplayPath(argv[++i]);
+        else if (strcmp(argv[i], "--instant") == 0) Game_SetInstant(true);
+        else if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc) Trace_Start(argv[++i]);
+    }
+    Game_SetSeed(seed);
 
     // Set a safe window size first
     CP_System_SetWindowSize(1280, 720);
 
     // Load card catalogue ONCE at startup
-    catalogue_size = LoadCatalogue("Assets/cath.txt", catalogue, 50);
-    if (catalogue_size == 0) {
+    if (LoadCatalogue("Assets/cath.txt", &catalogue) == 0) {
         printf("WARNING: Failed to load card catalogue!\n");
     }
 
+    // Load the encounter table (from its compiled cache when it's up to date)
+    if (Levels_Load("Assets/levels.txt") == 0) {
+        printf("WARNING: Failed to load Assets/levels.txt, using built-in levels\n");
+    }
+
     // Set the initial game state to the main menu
     CP_Engine_SetNextGameState(Intro_Init, Intro_Update, Intro_Exit);
 
     // Run the engine (no arguments)
     CP_Engine_Run(60);
 
+    Asset_Shutdown();
+    Trace_Shutdown();
+    FreeCatalogue(&catalogue);
+
     return 0;
 }
\ No newline at end of file
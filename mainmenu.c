@@ -5,6 +5,8 @@
 #include "tutorial.h"
 #include "victory.h"
 #include "credit.h"
+#include "assets.h"
+#include "trace.h"
 
 #define BUTTON_WIDTH 300.0f
 #define BUTTON_HEIGHT 80.0f
@@ -17,13 +19,16 @@ static float button_quit_x, button_quit_y;
 static float button_credits_x, button_credits_y;
 
 static CP_Font menu_font;
+static AssetId menu_font_id = ASSET_NONE;
 
 // Initializes the menu system, resets game flags, loads assets, and lays out buttons.
 void Main_Menu_Init(void)
 {
+    Trace_AsyncBegin(TRACE_CAT_STATE, "Main Menu", TRACE_ID_SCREEN);
     Game_Set_Restart_Flag(false);
 
-    menu_font = CP_Font_Load("Assets/Exo2-Regular.ttf");
+    menu_font_id = Asset_Acquire(ASSET_FONT, "Assets/Exo2-Regular.ttf");
+    menu_font = Asset_Font(menu_font_id);
     CP_Font_Set(menu_font);
     CP_Settings_TextSize(32);
 
@@ -68,6 +73,9 @@ static void DrawButton(const char* text, float x, float y, float w, float h, int
 // Renders the background and buttons, and checks for mouse interaction to trigger state changes.
 void Main_Menu_Update(void)
 {
+    // Keep finishing preloads if the intro was skipped
+    Asset_Pump(ASSET_PUMP_BUDGET);
+
     CP_Graphics_ClearBackground(CP_Color_Create(20, 25, 28, 255));
 
     // Get mouse position
@@ -114,4 +122,7 @@ void Main_Menu_Update(void)
     }
 }
 
-void Main_Menu_Exit(void) {}
\ No newline at end of file
+void Main_Menu_Exit(void) {
+    Asset_Release(&menu_font_id);
+    Trace_AsyncEnd(TRACE_CAT_STATE, "Main Menu", TRACE_ID_SCREEN);
+}
\ No newline at end of file
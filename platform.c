@@ -0,0 +1,176 @@
+// @file platform.c
+// @brief Win32 / POSIX implementations of the thread, atomic, clock and file mapping helpers in platform.h.
+
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "platform.h"
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+struct PlatformThread {
+#if defined(_WIN32)
+    HANDLE handle;
+#else
+    pthread_t handle;
+#endif
+    PlatformThreadFunc func;
+    void* arg;
+};
+
+#if defined(_WIN32)
+static DWORD WINAPI ThreadEntry(LPVOID param) {
+    PlatformThread* thread = (PlatformThread*)param;
+    thread->func(thread->arg);
+    return 0;
+}
+#else
+static void* ThreadEntry(void* param) {
+    PlatformThread* thread = (PlatformThread*)param;
+    thread->func(thread->arg);
+    return NULL;
+}
+#endif
+
+PlatformThread* Platform_ThreadStart(PlatformThreadFunc func, void* arg) {
+    PlatformThread* thread = malloc(sizeof(PlatformThread));
+    if (!thread) return NULL;
+    thread->func = func;
+    thread->arg = arg;
+#if defined(_WIN32)
+    thread->handle = CreateThread(NULL, 0, ThreadEntry, thread, 0, NULL);
+    if (!thread->handle) { free(thread); return NULL; }
+#else
+    if (pthread_create(&thread->handle, NULL, ThreadEntry, thread) != 0) { free(thread); return NULL; }
+#endif
+    return thread;
+}
+
+void Platform_ThreadJoin(PlatformThread* thread) {
+    if (!thread) return;
+#if defined(_WIN32)
+    WaitForSingleObject(thread->handle, INFINITE);
+    CloseHandle(thread->handle);
+#else
+    pthread_join(thread->handle, NULL);
+#endif
+    free(thread);
+}
+
+int Platform_CpuCount(void) {
+#if defined(_WIN32)
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors > 0 ? (int)info.dwNumberOfProcessors : 1;
+#else
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? (int)count : 1;
+#endif
+}
+
+double Platform_Seconds(void) {
+#if defined(_WIN32)
+    LARGE_INTEGER freq, now;
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&now);
+    return (double)now.QuadPart / (double)freq.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+#endif
+}
+
+uint64_t Platform_AtomicLoad64(PlatformAtomic64* target) {
+#if defined(_MSC_VER)
+    return (uint64_t)InterlockedCompareExchange64(target, 0, 0);
+#else
+    return atomic_load(target);
+#endif
+}
+
+void Platform_AtomicStore64(PlatformAtomic64* target, uint64_t value) {
+#if defined(_MSC_VER)
+    InterlockedExchange64(target, (long long)value);
+#else
+    atomic_store(target, value);
+#endif
+}
+
+bool Platform_AtomicCompareExchange64(PlatformAtomic64* target, uint64_t expected, uint64_t desired) {
+#if defined(_MSC_VER)
+    return (uint64_t)InterlockedCompareExchange64(target, (long long)desired, (long long)expected) == expected;
+#else
+    return atomic_compare_exchange_strong(target, &expected, desired);
+#endif
+}
+
+bool Platform_MapFile(const char* path, PlatformMappedFile* out) {
+    if (!out) return false;
+    memset(out, 0, sizeof(*out));
+    if (!path) return false;
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart <= 0) { CloseHandle(file); return false; }
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (!mapping) { CloseHandle(file); return false; }
+    const void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!data) { CloseHandle(mapping); CloseHandle(file); return false; }
+    out->data = data;
+    out->size = (size_t)size.QuadPart;
+    out->file_handle = file;
+    out->map_handle = mapping;
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return false;
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size <= 0) { close(fd); return false; }
+    void* data = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // The mapping stays valid after the descriptor is closed
+    if (data == MAP_FAILED) return false;
+    out->data = data;
+    out->size = (size_t)info.st_size;
+#endif
+    return true;
+}
+
+void Platform_UnmapFile(PlatformMappedFile* file) {
+    if (!file || !file->data) return;
+#if defined(_WIN32)
+    UnmapViewOfFile(file->data);
+    CloseHandle((HANDLE)file->map_handle);
+    CloseHandle((HANDLE)file->file_handle);
+#else
+    munmap((void*)file->data, file->size);
+#endif
+    memset(file, 0, sizeof(*file));
+}
+
+bool Platform_FileStamp(const char* path, uint64_t* size, int64_t* mtime) {
+    if (!path) return false;
+#if defined(_WIN32)
+    struct _stat64 info;
+    if (_stat64(path, &info) != 0) return false;
+#else
+    struct stat info;
+    if (stat(path, &info) != 0) return false;
+#endif
+    if (size) *size = (uint64_t)info.st_size;
+    if (mtime) *mtime = (int64_t)info.st_mtime;
+    return true;
+}
@@ -0,0 +1,56 @@
+// Thin portability layer: threads, 64-bit atomics, a wall clock and read-only file mapping.
+// Win32 on Windows, pthreads / C11 atomics elsewhere. The game uses it for the asset preloader and
+// the trace recorder.
+#pragma once
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(_MSC_VER)
+typedef volatile long long PlatformAtomic64;
+#define PLATFORM_THREAD_LOCAL __declspec(thread)
+#else
+#include <stdatomic.h>
+typedef _Atomic uint64_t PlatformAtomic64;
+#define PLATFORM_THREAD_LOCAL _Thread_local
+#endif
+
+typedef struct PlatformThread PlatformThread;
+typedef void (*PlatformThreadFunc)(void* arg);
+
+typedef struct { // A whole file mapped read-only into memory.
+    const void* data;
+    size_t size;
+    void* file_handle; // Win32 only
+    void* map_handle;  // Win32 only
+} PlatformMappedFile;
+
+// Starts a thread running func(arg). Returns NULL on failure.
+PlatformThread* Platform_ThreadStart(PlatformThreadFunc func, void* arg);
+
+// Waits for the thread to finish and frees it.
+void Platform_ThreadJoin(PlatformThread* thread);
+
+// Returns the number of logical processors (at least 1).
+int Platform_CpuCount(void);
+
+// Returns a monotonic wall-clock time in seconds.
+double Platform_Seconds(void);
+
+// Atomically reads a 64-bit value.
+uint64_t Platform_AtomicLoad64(PlatformAtomic64* target);
+
+// Atomically writes a 64-bit value.
+void Platform_AtomicStore64(PlatformAtomic64* target, uint64_t value);
+
+// Atomically replaces *target with desired if it still equals expected. Returns true on success.
+bool Platform_AtomicCompareExchange64(PlatformAtomic64* target, uint64_t expected, uint64_t desired);
+
+// Maps an existing, non-empty file read-only. Returns false (and leaves out zeroed) on failure.
+bool Platform_MapFile(const char* path, PlatformMappedFile* out);
+
+// Unmaps a file opened with Platform_MapFile. Safe to call on a zeroed or already closed mapping.
+void Platform_UnmapFile(PlatformMappedFile* file);
+
+// Reads a file's size and last-write time. Returns false if the file doesn't exist.
+bool Platform_FileStamp(const char* path, uint64_t* size, int64_t* mtime);
@@ -0,0 +1,29 @@
+// Player stats structure, shared by the game screens and the headless combat rules.
+#pragma once
+#include <stdbool.h>
+
+// Represents the player's stats, buffs, and progress.
+typedef struct Player {
+    int health;
+    int max_health;
+    int attack;
+    int shield;
+
+    // --- Player Buffs ---
+    bool has_lifesteal;
+    bool has_desperate_draw;
+    bool has_divine_strike;
+    bool has_shield_boost;
+    bool has_attack_boost_35;
+    bool has_heal_boost_35;
+    bool has_shield_boost_35;
+
+    int checkpoint_level;
+    int death_count;
+
+    // --- Card Bonus Trackers ---
+    int attack_bonus;
+    int heal_bonus;
+    int shield_bonus;
+    int card_reward_count;
+} Player;
@@ -0,0 +1,104 @@
+// @file profiler.c
+// @brief Section timers, per-frame history ring and min/avg/p99 summaries.
+
+#include "profiler.h"
+#include "platform.h"
+#include "trace.h"
+#include <stdlib.h>
+#include <string.h>
+
+static const char* const* section_names = NULL;
+static int section_count = 0;
+
+// history[s][i]: milliseconds section s took in frame i of the ring. Row section_count is the whole frame.
+static float history[PROFILER_MAX_SECTIONS + 1][PROFILER_HISTORY];
+static int ring_next = 0;
+static int frames_recorded = 0;
+
+static double frame_ms[PROFILER_MAX_SECTIONS + 1]; // Current frame, accumulating
+static double frame_start = 0.0;
+static double section_start = 0.0;
+static int current_section = -1;
+static int in_frame = 0;
+
+void Profiler_Init(const char* const* names, int count) {
+    section_names = names;
+    section_count = count < PROFILER_MAX_SECTIONS ? count : PROFILER_MAX_SECTIONS;
+    memset(history, 0, sizeof(history));
+    ring_next = 0;
+    frames_recorded = 0;
+    in_frame = 0;
+    current_section = -1;
+}
+
+void Profiler_BeginFrame(void) {
+    memset(frame_ms, 0, sizeof(frame_ms));
+    Trace_Begin(TRACE_CAT_FRAME, "Frame");
+    frame_start = Platform_Seconds();
+    current_section = -1;
+    in_frame = 1;
+}
+
+static void CloseSection(double now) {
+    if (current_section < 0) return;
+    frame_ms[current_section] += (now - section_start) * 1000.0;
+    Trace_End(TRACE_CAT_FRAME, section_names[current_section]);
+    current_section = -1;
+}
+
+void Profiler_Mark(int section) {
+    if (!in_frame) return;
+    double now = Platform_Seconds();
+    CloseSection(now);
+    if (section < 0 || section >= section_count) return;
+    current_section = section;
+    section_start = now;
+    Trace_Begin(TRACE_CAT_FRAME, section_names[section]);
+}
+
+void Profiler_EndFrame(void) {
+    if (!in_frame) return;
+    double now = Platform_Seconds();
+    CloseSection(now);
+    frame_ms[section_count] = (now - frame_start) * 1000.0;
+    for (int s = 0; s <= section_count; s++) history[s][ring_next] = (float)frame_ms[s];
+    ring_next = (ring_next + 1) % PROFILER_HISTORY;
+    if (frames_recorded < PROFILER_HISTORY) frames_recorded++;
+    in_frame = 0;
+    Trace_End(TRACE_CAT_FRAME, "Frame");
+}
+
+static int CompareFloats(const void* a, const void* b) {
+    float x = *(const float*)a, y = *(const float*)b;
+    return (x > y) - (x < y);
+}
+
+static ProfilerStat Summarize(int row, const char* name) {
+    ProfilerStat stat = { name, 0.0f, 0.0f, 0.0f, 0.0f };
+    if (frames_recorded == 0) return stat;
+
+    float sorted[PROFILER_HISTORY];
+    memcpy(sorted, history[row], sizeof(float) * (size_t)frames_recorded); // The ring fills from 0
+    qsort(sorted, (size_t)frames_recorded, sizeof(float), CompareFloats);
+
+    double sum = 0.0;
+    for (int i = 0; i < frames_recorded; i++) sum += sorted[i];
+    int p99_index = (frames_recorded * 99 + 99) / 100 - 1; // Nearest-rank percentile
+
+    stat.last_ms = history[row][(ring_next + PROFILER_HISTORY - 1) % PROFILER_HISTORY];
+    stat.min_ms = sorted[0];
+    stat.avg_ms = (float)(sum / frames_recorded);
+    stat.p99_ms = sorted[p99_index];
+    return stat;
+}
+
+int Profiler_Stats(ProfilerStat* out, int max) {
+    int written = 0;
+    for (int s = 0; s < section_count && written < max; s++) out[written++] = Summarize(s, section_names[s]);
+    if (written < max) out[written++] = Summarize(section_count, "Frame");
+    return written;
+}
+
+int Profiler_FrameCount(void) {
+    return frames_recorded;
+}
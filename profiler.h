@@ -0,0 +1,36 @@
+// Frame profiler: the sections of a frame are timed with the wall clock and kept for the last
+// PROFILER_HISTORY frames, then summarized as min / average / 99th percentile. Sections are marked
+// one after another, so marking one ends the previous. Every frame and section is also a trace span
+// (trace.h). Never touches CProcessing.
+#pragma once
+
+#define PROFILER_MAX_SECTIONS 24
+#define PROFILER_HISTORY 240 // Frames kept: 4 seconds at 60 fps
+
+// Timing summary for one section (or the whole frame) over the kept frames, in milliseconds.
+typedef struct {
+    const char* name;
+    float last_ms;
+    float min_ms;
+    float avg_ms;
+    float p99_ms;
+} ProfilerStat;
+
+// Names the sections; section ids are indices into names. Clears the history.
+void Profiler_Init(const char* const* names, int count);
+
+// Starts timing a frame.
+void Profiler_BeginFrame(void);
+
+// Ends the running section (if any) and starts timing section. A section marked twice in a frame adds up.
+void Profiler_Mark(int section);
+
+// Ends the running section and the frame, and stores the frame's times. Sections not marked count as 0.
+void Profiler_EndFrame(void);
+
+// Fills out with one entry per section and a last "Frame" entry for the whole frame.
+// Returns the number of entries written (at most max).
+int Profiler_Stats(ProfilerStat* out, int max);
+
+// Returns how many frames the stats cover (up to PROFILER_HISTORY).
+int Profiler_FrameCount(void);
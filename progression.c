@@ -0,0 +1,152 @@
+// @file progression.c
+// @brief Render-free progression rules used by reward.c, buff_reward.c, deck.c and the run simulator.
+
+#include "progression.h"
+#include <stddef.h>
+
+void Progression_ResetPlayer(Player* player) {
+    if (!player) return;
+
+    player->health = PLAYER_START_HEALTH;
+    player->max_health = PLAYER_START_HEALTH;
+    player->attack = PLAYER_START_ATTACK;
+    player->shield = PLAYER_START_SHIELD;
+    // Reset all buffs
+    player->has_lifesteal = false;
+    player->has_desperate_draw = false;
+    player->has_divine_strike = false;
+    player->has_shield_boost = false;
+    player->has_attack_boost_35 = false;
+    player->has_heal_boost_35 = false;
+    player->has_shield_boost_35 = false;
+
+    player->checkpoint_level = 1;
+    player->death_count = 0;
+    player->attack_bonus = 0;
+    player->heal_bonus = 0;
+    player->shield_bonus = 0;
+    player->card_reward_count = 0;
+}
+
+bool Progression_IsBossLevel(int level) {
+    return level == 3 || level == 6 || level == 9;
+}
+
+int Progression_CardsPerTurn(const Player* player) {
+    // Draw 1 extra card with the Card Mastery buff
+    return (player && player->has_desperate_draw) ? 5 : 4;
+}
+
+bool Progression_ApplyCardReward(Player* player, CardType reward_type) {
+    if (!player) return false;
+
+    // The bonus grows with every card reward taken
+    int buff_increase = 2 + player->card_reward_count;
+    bool first_pick = false;
+    player->card_reward_count++;
+
+    if (reward_type == Attack) {
+        first_pick = (player->attack_bonus == 0);
+        player->attack_bonus += buff_increase;
+    }
+    else if (reward_type == Heal) {
+        first_pick = (player->heal_bonus == 0);
+        player->heal_bonus += buff_increase;
+    }
+    else if (reward_type == Shield) {
+        first_pick = (player->shield_bonus == 0);
+        player->shield_bonus += buff_increase;
+    }
+    return first_pick;
+}
+
+int Progression_CardBonus(const Player* player, CardType type) {
+    if (!player) return 0;
+    switch (type) {
+    case Attack: return player->attack_bonus;
+    case Heal:   return player->heal_bonus;
+    case Shield: return player->shield_bonus;
+    }
+    return 0;
+}
+
+CardEffect Progression_RewardSpecialEffect(CardType reward_type) {
+    switch (reward_type) {
+    case Attack: return CLEAVE;
+    case Heal:   return DIVINE_STRIKE_EFFECT;
+    case Shield: return SHIELD_BASH;
+    }
+    return None;
+}
+
+int Progression_RewardSpecialPower(CardType reward_type) {
+    switch (reward_type) {
+    case Attack: return CLEAVE_POWER;
+    case Heal:   return DIVINE_POWER;
+    case Shield: return BASH_POWER;
+    }
+    return 0;
+}
+
+void Progression_GetBuffChoices(int level, BuffType out[BOSS_BUFF_OPTIONS]) {
+    if (level == 3) {
+        out[0] = BUFF_LIFESTEAL;
+        out[1] = BUFF_DESPERATE_DRAW;
+        out[2] = BUFF_SHIELD_BOOST;
+    }
+    else if (level == 6) {
+        out[0] = BUFF_ATTACK_BOOST_35;
+        out[1] = BUFF_HEAL_BOOST_35;
+        out[2] = BUFF_SHIELD_BOOST_35;
+    }
+    else {
+        out[0] = BUFF_LIFESTEAL;
+        out[1] = BUFF_DESPERATE_DRAW;
+        out[2] = BUFF_ATTACK_UP;
+    }
+}
+
+int Progression_BuffAttackGain(int level) {
+    int boss_count = (level / 3) - 1; // Lvl 3 -> 0, Lvl 6 -> 1, Lvl 9 -> 2
+    return 2 + (1 * boss_count);
+}
+
+void Progression_ApplyBuff(Player* player, BuffType buff) {
+    if (!player) return;
+
+    // --- Calculate scaling buff amount ---
+    int boss_count = 0;
+    if (player->max_health > 50) boss_count++; // Simple check if Lvl 3 buff was taken
+    if (player->max_health > 70) boss_count++; // Simple check if Lvl 6 buff was taken
+    int attack_gain = 2 + (1 * boss_count);
+
+    switch (buff) {
+    case BUFF_LIFESTEAL:
+        player->has_lifesteal = true;
+        break;
+    case BUFF_DESPERATE_DRAW:
+        player->has_desperate_draw = true;
+        break;
+    case BUFF_DIVINE_STRIKE:
+        player->has_divine_strike = true;
+        break;
+    case BUFF_SHIELD_BOOST:
+        player->has_shield_boost = true;
+        break;
+    case BUFF_ATTACK_UP:
+        player->attack += attack_gain;
+        break;
+    case BUFF_ATTACK_BOOST_35:
+        player->has_attack_boost_35 = true;
+        break;
+    case BUFF_HEAL_BOOST_35:
+        player->has_heal_boost_35 = true;
+        break;
+    case BUFF_SHIELD_BOOST_35:
+        player->has_shield_boost_35 = true;
+        break;
+    case BUFF_NONE:
+        // Do nothing
+        break;
+    }
+}
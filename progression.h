@@ -0,0 +1,70 @@
+// Headless progression rules: starting stats, starting deck, card-reward bonuses and boss buffs.
+// Shared by the reward screens and the run simulator so both apply identical numbers.
+#pragma once
+#include <stdbool.h>
+#include "player.h"
+#include "carddef.h"
+
+// --- Player starting stats ---
+#define PLAYER_START_HEALTH 80
+#define PLAYER_START_ATTACK 7
+#define PLAYER_START_SHIELD 0
+
+// --- Starting deck: 6 Attacks, 4 Heals, 4 Shields ---
+#define STARTING_ATTACK_CARDS 6
+#define STARTING_HEAL_CARDS 4
+#define STARTING_SHIELD_CARDS 4
+#define BASIC_ATTACK_POWER 7
+#define BASIC_HEAL_POWER 7
+#define BASIC_SHIELD_POWER 5
+
+// --- Special cards granted the first time a card reward type is picked ---
+#define REWARD_SPECIAL_CARD_COUNT 2
+#define CLEAVE_POWER 7
+#define DIVINE_POWER 7
+#define BASH_POWER 5
+
+#define BOSS_BUFF_OPTIONS 3
+
+typedef enum {
+    BUFF_NONE,
+    BUFF_LIFESTEAL,
+    BUFF_DESPERATE_DRAW,
+    BUFF_DIVINE_STRIKE,
+    BUFF_SHIELD_BOOST,
+    BUFF_ATTACK_UP,
+    BUFF_ATTACK_BOOST_35,
+    BUFF_HEAL_BOOST_35,
+    BUFF_SHIELD_BOOST_35
+} BuffType;
+
+// Resets every player stat, buff and bonus to a fresh-game state.
+void Progression_ResetPlayer(Player* player);
+
+// Returns true if the level number is a boss level (grants a buff instead of a card reward).
+bool Progression_IsBossLevel(int level);
+
+// Returns the number of cards dealt at the start of each turn.
+int Progression_CardsPerTurn(const Player* player);
+
+// Applies a card reward of the given type (Attack, Heal or Shield) to the player's bonuses.
+// Returns true if this was the first pick of that type, meaning the special cards should be added.
+bool Progression_ApplyCardReward(Player* player, CardType reward_type);
+
+// Returns the flat bonus card rewards have added to every card of the given type.
+int Progression_CardBonus(const Player* player, CardType type);
+
+// Returns the special card effect added by the first card reward of the given type.
+CardEffect Progression_RewardSpecialEffect(CardType reward_type);
+
+// Returns the base power of the special card added by a card reward of the given type.
+int Progression_RewardSpecialPower(CardType reward_type);
+
+// Fills out with the buffs offered after clearing the given boss level.
+void Progression_GetBuffChoices(int level, BuffType out[BOSS_BUFF_OPTIONS]);
+
+// Returns the attack gained from the Rage buff after the given boss level.
+int Progression_BuffAttackGain(int level);
+
+// Applies a permanent boss buff to the player.
+void Progression_ApplyBuff(Player* player, BuffType buff);
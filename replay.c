@@ -0,0 +1,275 @@
+// @file replay.c
+// @brief Replay log storage and headless playback through the combat and progression rules.
+//
+// File layout (little-endian): "CRPL", u16 version, u16 record size, u64 seed, u32 record count,
+// then the records as 4 raw bytes each. A 9-level run is a few hundred records, about a kilobyte.
+
+#include "replay.h"
+#include "combat.h"
+#include "progression.h"
+#include "levels.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define REPLAY_MAX_HAND 7
+#define REPLAY_MAX_RECORDS (1 << 24) // Sanity limit for files read from disk
+#define REPLAY_HEADER_SIZE 20
+#define REPLAY_LAST_LEVEL 9
+#define REPLAY_CHEAT_DAMAGE 10 // Same as the developer cheat in Game_Update
+
+static const char* const op_names[REPLAY_OP_COUNT] = {
+    "?", "LEVEL", "DEAL", "SELECT", "TARGET", "PLAY", "END_TURN", "REWARD", "BUFF", "CHEAT", "DEATH", "RESTART", "WIN"
+};
+
+const char* Replay_OpName(int op) {
+    return (op > 0 && op < REPLAY_OP_COUNT) ? op_names[op] : op_names[0];
+}
+
+void Replay_Begin(ReplayLog* log, uint64_t seed) {
+    if (!log) return;
+    log->seed = seed;
+    log->count = 0;
+}
+
+static uint8_t ArgByte(int value) {
+    if (value < 0) return REPLAY_NONE;
+    return (uint8_t)(value > 0xFF ? 0xFF : value);
+}
+
+void Replay_Record(ReplayLog* log, ReplayOp op, int a, int b, int c) {
+    if (!log) return;
+    if (log->count == log->capacity) {
+        int capacity = log->capacity ? log->capacity * 2 : 256;
+        ReplayRecord* grown = realloc(log->records, sizeof(ReplayRecord) * (size_t)capacity);
+        if (!grown) return;
+        log->records = grown;
+        log->capacity = capacity;
+    }
+    ReplayRecord* record = &log->records[log->count++];
+    record->op = (uint8_t)op;
+    record->a = ArgByte(a);
+    record->b = ArgByte(b);
+    record->c = ArgByte(c);
+}
+
+void Replay_Free(ReplayLog* log) {
+    if (!log) return;
+    free(log->records);
+    memset(log, 0, sizeof(*log));
+}
+
+// --- File I/O ---
+
+static void PutU16(uint8_t* out, uint16_t v) { out[0] = (uint8_t)v; out[1] = (uint8_t)(v >> 8); }
+static void PutU32(uint8_t* out, uint32_t v) { PutU16(out, (uint16_t)v); PutU16(out + 2, (uint16_t)(v >> 16)); }
+static void PutU64(uint8_t* out, uint64_t v) { PutU32(out, (uint32_t)v); PutU32(out + 4, (uint32_t)(v >> 32)); }
+static uint16_t GetU16(const uint8_t* in) { return (uint16_t)(in[0] | (in[1] << 8)); }
+static uint32_t GetU32(const uint8_t* in) { return (uint32_t)GetU16(in) | ((uint32_t)GetU16(in + 2) << 16); }
+static uint64_t GetU64(const uint8_t* in) { return (uint64_t)GetU32(in) | ((uint64_t)GetU32(in + 4) << 32); }
+
+bool Replay_Save(const ReplayLog* log, const char* path) {
+    if (!log || !path) return false;
+    FILE* file = fopen(path, "wb");
+    if (!file) return false;
+
+    uint8_t header[REPLAY_HEADER_SIZE];
+    memcpy(header, "CRPL", 4);
+    PutU16(header + 4, REPLAY_VERSION);
+    PutU16(header + 6, (uint16_t)sizeof(ReplayRecord));
+    PutU64(header + 8, log->seed);
+    PutU32(header + 16, (uint32_t)log->count);
+
+    bool ok = fwrite(header, 1, sizeof(header), file) == sizeof(header);
+    if (ok && log->count > 0) ok = fwrite(log->records, sizeof(ReplayRecord), (size_t)log->count, file) == (size_t)log->count;
+    return fclose(file) == 0 && ok;
+}
+
+bool Replay_Load(ReplayLog* log, const char* path) {
+    if (!log || !path) return false;
+    FILE* file = fopen(path, "rb");
+    if (!file) return false;
+
+    uint8_t header[REPLAY_HEADER_SIZE];
+    bool ok = fread(header, 1, sizeof(header), file) == sizeof(header)
+        && memcmp(header, "CRPL", 4) == 0
+        && GetU16(header + 4) == REPLAY_VERSION
+        && GetU16(header + 6) == sizeof(ReplayRecord);
+    uint32_t count = ok ? GetU32(header + 16) : 0;
+    if (count > REPLAY_MAX_RECORDS) ok = false;
+
+    if (ok && (int)count > log->capacity) {
+        ReplayRecord* grown = realloc(log->records, sizeof(ReplayRecord) * (size_t)count);
+        if (grown) {
+            log->records = grown;
+            log->capacity = (int)count;
+        }
+        else ok = false;
+    }
+    if (ok && count > 0) ok = fread(log->records, sizeof(ReplayRecord), count, file) == count;
+    fclose(file);
+
+    log->seed = ok ? GetU64(header + 8) : 0;
+    log->count = ok ? (int)count : 0;
+    return ok;
+}
+
+// --- Playback ---
+
+typedef struct {
+    CardType type;
+    CardEffect effect;
+    int power;
+} ReplayCard;
+
+typedef struct {
+    Player player;
+    Encounter encounter;
+    CombatState combat;
+    ReplayCard hand[REPLAY_MAX_HAND];
+    int hand_size;
+    int level;
+    bool in_fight; // Between LEVEL and the death or reward that ends it
+    bool cleared;  // Every enemy of the current level is dead
+} ReplayState;
+
+static void TraceState(FILE* trace, int index, const ReplayRecord* record, const ReplayState* state) {
+    fprintf(trace, "%6d %-8s %3d %3d %3d | L%d hp %3d/%3d sh %3d | hand %d | enemies",
+        index, Replay_OpName(record->op), record->a, record->b, record->c, state->level,
+        state->player.health, state->player.max_health, state->player.shield, state->hand_size);
+    for (int i = 0; i < state->encounter.enemy_count; i++) {
+        if (state->encounter.alive[i]) fprintf(trace, " %d+%d", state->encounter.health[i], state->encounter.shield[i]);
+        else fprintf(trace, " x");
+    }
+    fprintf(trace, "\n");
+}
+
+// Applies one record. Returns NULL, or a description of why the rules disagree with it.
+static const char* Step(ReplayState* state, const ReplayRecord* record, ReplayResult* result) {
+    switch (record->op) {
+    case REPLAY_LEVEL:
+        if (!Levels_Get(record->a)) return "level doesn't exist";
+        if (state->in_fight && !state->cleared) return "level started before the last one ended";
+        state->level = record->a;
+        state->player.checkpoint_level = record->a;
+        state->player.shield = PLAYER_START_SHIELD; // Before Combat_Init so the hash sees it
+        Encounter_Load(&state->encounter, record->a);
+        Combat_Init(&state->combat, &state->player, &state->encounter);
+        state->hand_size = 0;
+        state->in_fight = true;
+        state->cleared = false;
+        return NULL;
+
+    case REPLAY_DEAL:
+        if (!state->in_fight || state->cleared) return "card dealt outside a fight";
+        if (state->hand_size >= REPLAY_MAX_HAND) return "hand overflow";
+        if (record->a > Shield || record->b > DIVINE_STRIKE_EFFECT) return "unknown card";
+        state->hand[state->hand_size].type = (CardType)record->a;
+        state->hand[state->hand_size].effect = (CardEffect)record->b;
+        state->hand[state->hand_size].power = record->c;
+        state->hand_size++;
+        return NULL;
+
+    case REPLAY_SELECT:
+    case REPLAY_TARGET:
+        return NULL; // Presentation only; kept for bug reports and traces
+
+    case REPLAY_PLAY: {
+        if (!state->in_fight || state->cleared) return "card played outside a fight";
+        if (record->a >= state->hand_size) return "played card isn't in hand";
+        ReplayCard card = state->hand[record->a];
+        int target = record->b == REPLAY_NONE ? -1 : record->b;
+        if (!Combat_ApplyCard(&state->combat, card.type, card.effect, card.power, target)) return "card has no valid target";
+        memmove(&state->hand[record->a], &state->hand[record->a + 1], sizeof(ReplayCard) * (size_t)(state->hand_size - record->a - 1));
+        state->hand_size--;
+        result->plays++;
+        if (Combat_AllEnemiesDefeated(&state->combat)) {
+            state->cleared = true;
+            result->levels_cleared++;
+        }
+        return NULL;
+    }
+
+    case REPLAY_END_TURN:
+        if (state->cleared) return NULL; // The auto-end can fire in the frame the last enemy dies
+        if (!state->in_fight) return "turn ended outside a fight";
+        state->hand_size = 0;
+        Combat_RunEnemyTurn(&state->combat);
+        result->turns++;
+        return NULL;
+
+    case REPLAY_REWARD:
+        if (!state->in_fight || !state->cleared) return "reward before the level was cleared";
+        if (Progression_IsBossLevel(state->level)) return "card reward after a boss level";
+        if (record->a > Shield) return "unknown reward";
+        Progression_ApplyCardReward(&state->player, (CardType)record->a);
+        state->in_fight = false;
+        return NULL;
+
+    case REPLAY_BUFF:
+        if (!state->in_fight || !state->cleared) return "buff before the level was cleared";
+        if (!Progression_IsBossLevel(state->level)) return "buff after a normal level";
+        if (record->a > BUFF_SHIELD_BOOST_35) return "unknown buff";
+        Progression_ApplyBuff(&state->player, (BuffType)record->a);
+        state->in_fight = false;
+        return NULL;
+
+    case REPLAY_CHEAT: // A cheat during the enemy animation lands after the whole enemy turn here
+        if (!state->in_fight || state->cleared) return "cheat outside a fight";
+        if (record->a >= state->encounter.enemy_count || !state->encounter.alive[record->a]) return "cheat on a dead enemy";
+        state->encounter.health[record->a] -= REPLAY_CHEAT_DAMAGE;
+        if (state->encounter.health[record->a] <= 0) state->encounter.alive[record->a] = 0;
+        Combat_Rehash(&state->combat);
+        if (Combat_AllEnemiesDefeated(&state->combat)) {
+            state->cleared = true;
+            result->levels_cleared++;
+        }
+        return NULL;
+
+    case REPLAY_DEATH:
+        if (!state->in_fight || record->a != state->level) return "death on the wrong level";
+        if (state->player.health > 0) return "player is still alive";
+        state->in_fight = false;
+        result->deaths++;
+        result->death_level = state->level;
+        return NULL;
+
+    case REPLAY_RESTART:
+        if (result->death_level == 0) return "restart without a death";
+        state->player.health = state->player.max_health;
+        state->player.shield = PLAYER_START_SHIELD;
+        result->death_level = 0;
+        return NULL;
+
+    case REPLAY_WIN:
+        if (!state->cleared || (state->level < REPLAY_LAST_LEVEL && Levels_Get(state->level + 1))) return "win before the last level";
+        result->won = true;
+        return NULL;
+
+    default:
+        return "unknown record";
+    }
+}
+
+bool Replay_Play(const ReplayLog* log, ReplayResult* result, FILE* trace) {
+    memset(result, 0, sizeof(*result));
+    result->drift_at = -1;
+    if (!log) return false;
+
+    ReplayState state;
+    memset(&state, 0, sizeof(state));
+    Progression_ResetPlayer(&state.player);
+    Combat_Init(&state.combat, &state.player, NULL);
+
+    for (int i = 0; i < log->count; i++) {
+        const ReplayRecord* record = &log->records[i];
+        const char* drift = Step(&state, record, result);
+        if (trace) TraceState(trace, i, record, &state);
+        if (drift) {
+            result->drift_at = i;
+            snprintf(result->drift, sizeof(result->drift), "%s %d %d %d: %s",
+                Replay_OpName(record->op), record->a, record->b, record->c, drift);
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,76 @@
+// Replay logs: every decision of a run in a compact binary file, plus a headless player that re-runs
+// the log through the combat and progression rules. The game records, the simulator plays back.
+// Dealt hands are logged too, so playback never depends on the deck or its animation timing.
+#pragma once
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define REPLAY_VERSION 1
+#define REPLAY_NONE 0xFF // Argument value for "no card" / "no target"
+
+// What a record stands for. Arguments a, b, c are listed per op.
+typedef enum {
+    REPLAY_LEVEL = 1, // A level starts: a = level
+    REPLAY_DEAL,      // A card is dealt to the end of the hand: a = type, b = effect, c = power
+    REPLAY_SELECT,    // The highlighted card changed: a = hand index (REPLAY_NONE for none)
+    REPLAY_TARGET,    // The targeted enemy changed: a = enemy index (REPLAY_NONE for none)
+    REPLAY_PLAY,      // A card resolved: a = hand index, b = target (REPLAY_NONE for none)
+    REPLAY_END_TURN,  // The player turn ended: a = 1 if it ended on its own after the third play
+    REPLAY_REWARD,    // Card reward taken: a = CardType
+    REPLAY_BUFF,      // Boss buff taken: a = BuffType
+    REPLAY_CHEAT,     // Developer cheat: a = enemy index that lost 10 health
+    REPLAY_DEATH,     // The player died: a = level
+    REPLAY_RESTART,   // The player respawned at the checkpoint with full health: a = level
+    REPLAY_WIN,       // The last level was cleared
+    REPLAY_OP_COUNT
+} ReplayOp;
+
+// One input, 4 bytes on disk. Hand indices count only cards still in hand (not ones being discarded).
+typedef struct {
+    uint8_t op;
+    uint8_t a, b, c;
+} ReplayRecord;
+
+// A growable log for one run.
+typedef struct {
+    uint64_t seed; // Run seed, for reference (playback doesn't need it)
+    ReplayRecord* records;
+    int count;
+    int capacity;
+} ReplayLog;
+
+// Outcome of playing a log back.
+typedef struct {
+    bool won;
+    int death_level;    // Level of the last death if the run ended there, 0 otherwise
+    int deaths;
+    int levels_cleared;
+    int turns;
+    int plays;
+    int drift_at;       // Index of the first record the rules disagree with, -1 if none
+    char drift[96];     // What disagreed
+} ReplayResult;
+
+// Empties the log and starts a new run. Keeps the buffer for reuse.
+void Replay_Begin(ReplayLog* log, uint64_t seed);
+
+// Appends one record. Arguments are clamped to a byte; negative values become REPLAY_NONE.
+void Replay_Record(ReplayLog* log, ReplayOp op, int a, int b, int c);
+
+// Frees the log's buffer.
+void Replay_Free(ReplayLog* log);
+
+// Writes the log to path. Returns false on I/O failure.
+bool Replay_Save(const ReplayLog* log, const char* path);
+
+// Reads a log written by Replay_Save into log (replacing its contents). Returns false on failure.
+bool Replay_Load(ReplayLog* log, const char* path);
+
+// Re-runs the log from a fresh player through the current rules and levels (load them first).
+// Stops at the first record that disagrees with the rules. With trace set, prints every record and
+// the state after it. Returns true if the whole log played back without drift.
+bool Replay_Play(const ReplayLog* log, ReplayResult* result, FILE* trace);
+
+// Returns a short name for an op ("PLAY", "END_TURN", ...).
+const char* Replay_OpName(int op);
@@ -1,7 +1,10 @@
 #define _CRT_SECURE_NO_WARNINGS 
 #include "reward.h"
+#include "deck.h"
+#include "progression.h"
 #include "cprocessing.h"
 #include "utils.h"
+#include "assets.h"
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
@@ -25,7 +28,7 @@ void InitReward(RewardState* reward_state) {
     reward_state->show_confirm_button = false;
 
     if (!font_loaded) {
-        reward_font = CP_Font_Load("Assets/Roboto-Regular.ttf");
+        reward_font = Asset_Font(Asset_Acquire(ASSET_FONT, "Assets/Roboto-Regular.ttf")); // Held for the session
         font_loaded = true;
     }
 }
@@ -48,65 +51,47 @@ void GenerateRewardOptions(RewardState* reward_state, Player* player) {
     int next_heal_bonus = player->heal_bonus + buff_increase;
     int next_shield_bonus = player->shield_bonus + buff_increase;
 
-    char attack_desc[200];
-    char heal_desc[200];
-    char shield_desc[200];
-
     // Conditional descriptions: If it's the first time, we mention adding special cards.
-    // Otherwise, we just mention the passive buff increase.
-    if (player->attack_bonus == 0) {
-        snprintf(attack_desc, sizeof(attack_desc), "Add 2 Cleave.\n\nAll Atk Cards\n+%d Dmg.", next_attack_bonus);
-    }
-    else {
-        snprintf(attack_desc, sizeof(attack_desc), "All Atk Cards\n+%d Dmg.", next_attack_bonus);
-    }
-
-    if (player->heal_bonus == 0) {
-        snprintf(heal_desc, sizeof(heal_desc), "Add 2 Divine.\n\nAll Heal Cards\n+%d HP.", next_heal_bonus);
-    }
-    else {
-        snprintf(heal_desc, sizeof(heal_desc), "All Heal Cards\n+%d HP.", next_heal_bonus);
-    }
-
-    if (player->shield_bonus == 0) {
-        snprintf(shield_desc, sizeof(shield_desc), "Add 2 Bash.\n\nAll Shield Cards\n+%d Shield.", next_shield_bonus);
-    }
-    else {
-        snprintf(shield_desc, sizeof(shield_desc), "All Shield Cards\n+%d Shield.", next_shield_bonus);
-    }
-
+    // Otherwise, we just mention the passive buff increase. Formatted only when drawn.
+    const char* attack_blurb = (player->attack_bonus == 0)
+        ? "Add 2 Cleave.\n\nAll Atk Cards\n+{value} Dmg." : "All Atk Cards\n+{value} Dmg.";
+    const char* heal_blurb = (player->heal_bonus == 0)
+        ? "Add 2 Divine.\n\nAll Heal Cards\n+{value} HP." : "All Heal Cards\n+{value} HP.";
+    const char* shield_blurb = (player->shield_bonus == 0)
+        ? "Add 2 Bash.\n\nAll Shield Cards\n+{value} Shield." : "All Shield Cards\n+{value} Shield.";
 
     // Setup the actual Card data structures for the UI to draw
+    RegisterBuiltinCards();
     Card attack_reward = {
-        card_pos, card_pos, Attack, CLEAVE, 7, "",
-        card_w, card_h, false, false
+        .pos = card_pos, .prev_pos = card_pos, .target_pos = card_pos, .card_w = card_w, .card_h = card_h,
+        .id = CardDef_Find(Attack, CLEAVE, CLEAVE_POWER)
     };
-    strncpy(attack_reward.description, attack_desc, sizeof(attack_reward.description) - 1);
-
-
     Card heal_reward = {
-        card_pos, card_pos, Heal, DIVINE_STRIKE_EFFECT, 7, "",
-        card_w, card_h, false, false
+        .pos = card_pos, .prev_pos = card_pos, .target_pos = card_pos, .card_w = card_w, .card_h = card_h,
+        .id = CardDef_Find(Heal, DIVINE_STRIKE_EFFECT, DIVINE_POWER)
     };
-    strncpy(heal_reward.description, heal_desc, sizeof(heal_reward.description) - 1);
-
     Card shield_reward = {
-        card_pos, card_pos, Shield, SHIELD_BASH, 5, "",
-        card_w, card_h, false, false
+        .pos = card_pos, .prev_pos = card_pos, .target_pos = card_pos, .card_w = card_w, .card_h = card_h,
+        .id = CardDef_Find(Shield, SHIELD_BASH, BASH_POWER)
     };
-    strncpy(shield_reward.description, shield_desc, sizeof(shield_reward.description) - 1);
 
 
     // Store them in the reward state
     reward_state->options[0].card = attack_reward;
+    reward_state->options[0].blurb = attack_blurb;
+    reward_state->options[0].blurb_value = next_attack_bonus;
     reward_state->options[0].type = REWARD_ATTACK_CARD;
     reward_state->options[0].is_selected = false;
 
     reward_state->options[1].card = heal_reward;
+    reward_state->options[1].blurb = heal_blurb;
+    reward_state->options[1].blurb_value = next_heal_bonus;
     reward_state->options[1].type = REWARD_HEAL_CARD;
     reward_state->options[1].is_selected = false;
 
     reward_state->options[2].card = shield_reward;
+    reward_state->options[2].blurb = shield_blurb;
+    reward_state->options[2].blurb_value = next_shield_bonus;
     reward_state->options[2].type = REWARD_SHIELD_CARD;
     reward_state->options[2].is_selected = false;
 
@@ -222,7 +207,7 @@ void DrawReward(RewardState* reward_state, Player* player) {
             }
             else {
                 // Grey out others
-                DrawCard(&reward_state->options[i].card);
+                DrawCardWithText(&reward_state->options[i].card, CardDef_FormatText(reward_state->options[i].blurb, reward_state->options[i].blurb_value));
                 CP_Settings_Fill(CP_Color_Create(0, 0, 0, 150));
                 CP_Graphics_DrawRect(card_x, card_y,
                     reward_state->options[i].card.card_w,
@@ -248,7 +233,7 @@ void DrawReward(RewardState* reward_state, Player* player) {
         CP_Settings_Stroke(CP_Color_Create(0, 0, 0, 255));
         CP_Settings_StrokeWeight(1);
 
-        DrawCard(&reward_state->options[i].card);
+        DrawCardWithText(&reward_state->options[i].card, CardDef_FormatText(reward_state->options[i].blurb, reward_state->options[i].blurb_value));
 
         // Draw "Current Bonus" text below card
         CP_Settings_Fill(CP_Color_Create(220, 220, 255, 255));
@@ -319,104 +304,21 @@ void ApplyRewardSelection(RewardState* reward_state, Deck* deck, Player* player)
         return;
     }
 
-    int buff_increase = 2 + player->card_reward_count;
     RewardType selected_type = reward_state->options[reward_state->selected_index].type;
-    Card selected_card_template = reward_state->options[reward_state->selected_index].card;
-
-    player->card_reward_count++;
-
-    char new_card_description[200];
-    char existing_normal_description[200];
-    char existing_special_description[200];
-
-    int new_bonus = 0;
-    bool add_cards = false;
-
-    // Logic based on what type was picked
-    // We update existing card descriptions in the deck to reflect new stats
-    if (selected_type == REWARD_ATTACK_CARD) {
-        if (player->attack_bonus == 0) add_cards = true; // Only add Special cards first time
-        player->attack_bonus += buff_increase;
-        new_bonus = player->attack_bonus;
-
-        snprintf(new_card_description, sizeof(new_card_description), "Cleave:\n%d Dmg (AOE)", 7 + new_bonus);
-        snprintf(existing_normal_description, sizeof(existing_normal_description), "Deal %d Dmg.", 7 + new_bonus);
-
-        for (int i = 0; i < deck->size; i++) {
-            if (deck->cards[i].type == Attack) {
-                if (deck->cards[i].effect == None) {
-                    strncpy(deck->cards[i].description, existing_normal_description, sizeof(deck->cards[i].description) - 1);
-                }
-                else if (deck->cards[i].effect == CLEAVE) {
-                    strncpy(deck->cards[i].description, new_card_description, sizeof(deck->cards[i].description) - 1);
-                }
-            }
-        }
-    }
-    else if (selected_type == REWARD_HEAL_CARD) {
-        if (player->heal_bonus == 0) add_cards = true;
-        player->heal_bonus += buff_increase;
-        new_bonus = player->heal_bonus;
-
-        snprintf(new_card_description, sizeof(new_card_description), "Divine:\nHeal %d\n50%% Dmg (AOE)", 7 + new_bonus);
-        snprintf(existing_normal_description, sizeof(existing_normal_description), "Heal %d HP.", 7 + new_bonus);
-
-        for (int i = 0; i < deck->size; i++) {
-            if (deck->cards[i].type == Heal) {
-                if (deck->cards[i].effect == None) {
-                    strncpy(deck->cards[i].description, existing_normal_description, sizeof(deck->cards[i].description) - 1);
-                }
-                else if (deck->cards[i].effect == DIVINE_STRIKE_EFFECT) {
-                    strncpy(deck->cards[i].description, new_card_description, sizeof(deck->cards[i].description) - 1);
-                }
-            }
-        }
-    }
-    else if (selected_type == REWARD_SHIELD_CARD) {
-        if (player->shield_bonus == 0) add_cards = true;
-        player->shield_bonus += buff_increase;
-        new_bonus = player->shield_bonus;
-
-        snprintf(existing_normal_description, sizeof(existing_normal_description), "Gain %d Shield.", 5 + new_bonus);
-        snprintf(existing_special_description, sizeof(existing_special_description), "Bash:\nGain %d Shield\n Damage dealt = Shield", 5 + new_bonus);
-
-        strncpy(new_card_description, existing_special_description, sizeof(new_card_description));
-
-        for (int i = 0; i < deck->size; i++) {
-            if (deck->cards[i].type == Shield) {
-                if (deck->cards[i].effect == None) {
-                    strncpy(deck->cards[i].description, existing_normal_description, sizeof(deck->cards[i].description) - 1);
-                }
-                else if (deck->cards[i].effect == SHIELD_BASH) {
-                    strncpy(deck->cards[i].description, existing_special_description, sizeof(deck->cards[i].description) - 1);
-                }
-            }
-        }
-    }
+    CardId selected_card_id = reward_state->options[reward_state->selected_index].card.id;
+
+    // Bonus and first-pick rules are shared with the run simulator. Card texts read the bonus when
+    // they're drawn, so there is nothing to rewrite here.
+    CardType reward_card_type = (selected_type == REWARD_ATTACK_CARD) ? Attack
+        : (selected_type == REWARD_HEAL_CARD) ? Heal
+        : Shield;
+    bool add_cards = Progression_ApplyCardReward(player, reward_card_type);
 
     // If this is the first time selecting this type, add 2 special cards to the deck
     if (add_cards) {
-        Card selected_card = selected_card_template;
-
-        CP_Vector deck_pos_topleft = CP_Vector_Set(50, 600);
-        selected_card.pos = CP_Vector_Set(
-            deck_pos_topleft.x + CARD_W_INIT / 2.0f,
-            deck_pos_topleft.y + CARD_H_INIT / 2.0f
-        );
-
-        selected_card.target_pos = CP_Vector_Set(0, 0);
-
-        // Ensure correct sizing
-        selected_card.card_w = CARD_W_INIT * CARD_SCALE;
-        selected_card.card_h = CARD_H_INIT * CARD_SCALE;
-
-        selected_card.is_animating = false;
-        selected_card.is_discarding = false;
-
-        strncpy(selected_card.description, new_card_description, sizeof(selected_card.description) - 1);
-
-        AddCardToDeck(deck, selected_card);
-        AddCardToDeck(deck, selected_card);
+        for (int i = 0; i < REWARD_SPECIAL_CARD_COUNT; i++) {
+            AddCardToDeck(deck, selected_card_id);
+        }
     }
 }
 
@@ -14,6 +14,8 @@ typedef enum {
 
 typedef struct {
     Card card;
+    const char* blurb; // Template for what picking this option does, drawn in place of the card's own text
+    int blurb_value;   // Fills {value} in blurb: the bonus after picking
     RewardType type;
     bool is_selected;
 } RewardOption;
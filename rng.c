@@ -0,0 +1,22 @@
+// @file rng.c
+// @brief Stream setup and range reduction for the counter-based generator in rng.h.
+
+#include "rng.h"
+
+void Rng_Init(Rng* rng, uint64_t seed, RngStream stream) {
+    // Distinct odd multipliers keep (seed, stream) pairs from colliding before the mix
+    rng->key = Rng_Mix(seed ^ (0xD1B54A32D192ED03ull * ((uint64_t)stream + 1)));
+    rng->counter = 0;
+}
+
+int Rng_Range(Rng* rng, int lo, int hi) {
+    if (hi <= lo) return lo;
+    uint64_t span = (uint64_t)((int64_t)hi - (int64_t)lo) + 1;
+    // Multiply-shift on the top 32 bits instead of a modulo: no division, bias below 2^-32 * span
+    uint64_t bits = Rng_Next(rng) >> 32;
+    return lo + (int)((bits * span) >> 32);
+}
+
+uint64_t Rng_SeedFor(uint64_t session_seed, uint64_t index) {
+    return Rng_Mix(session_seed + 0x9E3779B97F4A7C15ull * (index + 1));
+}
@@ -0,0 +1,43 @@
+// Counter-based random numbers. Every value is a pure function of (key, counter), so a stream can be
+// replayed, skipped ahead or owned by one thread without any shared state. Each subsystem draws from
+// its own stream, so an extra draw in one (say, an AI change) never shifts the shuffles of another.
+#pragma once
+#include <stdint.h>
+
+typedef enum {
+    RNG_STREAM_SHUFFLE, // Deck shuffles
+    RNG_STREAM_REWARD,  // Reward and buff picks
+    RNG_STREAM_AI,      // Card and target choices of simulated players
+    RNG_STREAM_COUNT
+} RngStream;
+
+typedef struct {
+    uint64_t key;     // Derived from (seed, stream)
+    uint64_t counter; // Number of values drawn so far
+} Rng;
+
+// SplitMix64 finalizer: a bijective 64-bit mix.
+static inline uint64_t Rng_Mix(uint64_t z) {
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+// Returns value number counter of the stream with the given key.
+static inline uint64_t Rng_At(uint64_t key, uint64_t counter) {
+    return Rng_Mix(key + 0x9E3779B97F4A7C15ull * (counter + 1));
+}
+
+// Returns the next 64 random bits of the stream.
+static inline uint64_t Rng_Next(Rng* rng) {
+    return Rng_At(rng->key, rng->counter++);
+}
+
+// Starts the given stream of a seed at its first value.
+void Rng_Init(Rng* rng, uint64_t seed, RngStream stream);
+
+// Returns a uniform integer in [lo, hi] (inclusive). Returns lo if hi <= lo.
+int Rng_Range(Rng* rng, int lo, int hi);
+
+// Derives the seed of the index-th run in a session, so each run can be replayed on its own.
+uint64_t Rng_SeedFor(uint64_t session_seed, uint64_t index);
@@ -0,0 +1,213 @@
+// @file run.c
+// @brief Headless campaign loop mirroring Game_Init -> LoadLevel -> Game_Update -> reward screens.
+//
+// Differences from the on-screen game, all timing-only: the enemy turn resolves in one step and the
+// discard pile is recycled right after dealing or discarding instead of after its animation.
+
+#include "run.h"
+#include "shuffle.h"
+#include "zobrist.h"
+#include <string.h>
+
+int Run_RandomRange(RunState* run, RngStream stream, int lo, int hi) {
+    if ((unsigned)stream >= RNG_STREAM_COUNT) stream = RNG_STREAM_AI;
+    return Rng_Range(&run->rng[stream], lo, hi);
+}
+
+// Returns the card i places below the top of the draw pile (i == draw_size is the slot past the bottom).
+static RunCard* DrawAt(RunState* run, int i) {
+    return &run->draw[(run->draw_head + i) & (RUN_MAX_CARDS - 1)];
+}
+
+// Fisher-Yates over the draw pile, same order of swaps as ShuffleDeck. The draws come from the
+// vectorized generator in shuffle.c.
+static void ShuffleDraw(RunState* run) {
+    uint8_t swaps[SHUFFLE_MAX_SIZE];
+    Shuffle_Draws(&run->rng[RNG_STREAM_SHUFFLE], run->draw_size, swaps);
+    for (int i = run->draw_size - 1; i > 0; i--) {
+        int j = swaps[i];
+        RunCard temp = *DrawAt(run, i);
+        *DrawAt(run, i) = *DrawAt(run, j);
+        *DrawAt(run, j) = temp;
+    }
+}
+
+static uint64_t RunCardKey(const RunCard* card) {
+    return Zobrist_CardKey(card->type, card->effect, card->power);
+}
+
+// With run->check_hashes set, recomputes the combat and hand hashes from scratch and counts every
+// disagreement with the incrementally updated ones.
+static void CheckHashes(RunState* run, RunResult* result) {
+    if (!run->check_hashes) return;
+    uint64_t hand_hash = 0;
+    for (int i = 0; i < run->hand_size; i++) hand_hash += RunCardKey(&run->hand[i]);
+    if (hand_hash != run->hand_hash) result->hash_mismatches++;
+    if (Zobrist_HashCombat(&run->player, &run->encounter) != run->combat.hash) result->hash_mismatches++;
+}
+
+static void AddToDraw(RunState* run, CardType type, CardEffect effect, int power) {
+    if (run->draw_size >= RUN_MAX_CARDS) return;
+    RunCard* card = DrawAt(run, run->draw_size++);
+    card->type = type;
+    card->effect = effect;
+    card->power = power;
+}
+
+// Moves the hand and discard pile back into the draw pile and shuffles (LoadLevel / RecycleDeck).
+static void GatherAllCards(RunState* run) {
+    for (int i = 0; i < run->hand_size; i++) *DrawAt(run, run->draw_size++) = run->hand[i];
+    for (int i = 0; i < run->discard_size; i++) *DrawAt(run, run->draw_size++) = run->discard[i];
+    run->hand_size = 0;
+    run->hand_hash = 0;
+    run->discard_size = 0;
+    ShuffleDraw(run);
+}
+
+// Shuffles the discard pile into the draw pile once it runs low, like the recycle step in Game_Update.
+static void RecycleIfLow(RunState* run) {
+    if (run->draw_size >= 4 || run->discard_size == 0) return;
+    for (int i = 0; i < run->discard_size; i++) *DrawAt(run, run->draw_size++) = run->discard[i];
+    run->discard_size = 0;
+    ShuffleDraw(run);
+}
+
+// Starts a fresh encounter for the level, like LoadLevel does.
+static void LoadEncounter(RunState* run, int level) {
+    Encounter_Load(&run->encounter, level);
+    Combat_Init(&run->combat, &run->player, &run->encounter);
+}
+
+// Fallback policy: first card that can be played, aimed at the first living enemy.
+static int FirstLegalCard(RunState* run, int* target) {
+    *target = -1;
+    for (int i = 0; i < run->encounter.enemy_count; i++) {
+        if (run->encounter.alive[i]) { *target = i; break; }
+    }
+    for (int i = 0; i < run->hand_size; i++) {
+        if (Combat_CanPlayCard(&run->combat, run->hand[i].type, run->hand[i].effect, *target)) return i;
+    }
+    return -1;
+}
+
+// Plays one player turn followed by the enemy turn. Returns true once the level is cleared.
+static bool PlayTurn(RunState* run, const RunPolicy* policy, RunResult* result) {
+    // Deal
+    int cards_to_draw = Progression_CardsPerTurn(&run->player);
+    for (int i = 0; i < cards_to_draw && run->draw_size > 0 && run->hand_size < RUN_MAX_HAND; i++) {
+        RunCard card = *DrawAt(run, 0);
+        run->draw_head = (run->draw_head + 1) & (RUN_MAX_CARDS - 1);
+        run->draw_size--;
+        run->hand[run->hand_size++] = card;
+        run->hand_hash += RunCardKey(&card);
+        Replay_Record(run->log, REPLAY_DEAL, card.type, card.effect, card.power);
+    }
+    RecycleIfLow(run);
+    run->played_cards = 0;
+    CheckHashes(run, result);
+
+    // Player phase
+    bool auto_end = false;
+    while (run->hand_size > 0) {
+        int target = -1;
+        int index = policy->choose_card ? policy->choose_card(run, &target, policy->ctx) : FirstLegalCard(run, &target);
+        if (index < 0 || index >= run->hand_size) break;
+
+        RunCard card = run->hand[index];
+        if (!Combat_ApplyCard(&run->combat, card.type, card.effect, card.power, target)) break;
+        Replay_Record(run->log, REPLAY_PLAY, index, target, 0);
+
+        run->discard[run->discard_size++] = card;
+        memmove(&run->hand[index], &run->hand[index + 1], sizeof(RunCard) * (size_t)(run->hand_size - index - 1));
+        run->hand_size--;
+        run->hand_hash -= RunCardKey(&card);
+        run->played_cards++;
+        CheckHashes(run, result);
+
+        if (Combat_AllEnemiesDefeated(&run->combat)) return true;
+        // Auto-end turn if less than 3 cards remain and 3 cards have been played
+        if (run->hand_size < 3 && run->played_cards == RUN_CARDS_PER_TURN_CAP) { auto_end = true; break; }
+    }
+    Replay_Record(run->log, REPLAY_END_TURN, auto_end, 0, 0);
+
+    // Discard the rest of the hand
+    for (int i = 0; i < run->hand_size; i++) run->discard[run->discard_size++] = run->hand[i];
+    run->hand_size = 0;
+    run->hand_hash = 0;
+    RecycleIfLow(run);
+
+    // Enemy phase
+    Combat_RunEnemyTurn(&run->combat);
+    CheckHashes(run, result);
+    run->turn++;
+    return false;
+}
+
+// Applies the reward screen that follows a cleared level.
+static void GrantReward(RunState* run, const RunPolicy* policy) {
+    if (Progression_IsBossLevel(run->level)) {
+        BuffType options[BOSS_BUFF_OPTIONS];
+        Progression_GetBuffChoices(run->level, options);
+        int pick = policy->choose_buff ? policy->choose_buff(run, options, policy->ctx) : 0;
+        if (pick < 0 || pick >= BOSS_BUFF_OPTIONS) pick = 0;
+        Progression_ApplyBuff(&run->player, options[pick]);
+        Replay_Record(run->log, REPLAY_BUFF, options[pick], 0, 0);
+    }
+    else {
+        CardType pick = policy->choose_reward ? policy->choose_reward(run, policy->ctx) : Attack;
+        Replay_Record(run->log, REPLAY_REWARD, pick, 0, 0);
+        if (Progression_ApplyCardReward(&run->player, pick)) {
+            for (int i = 0; i < REWARD_SPECIAL_CARD_COUNT; i++) {
+                AddToDraw(run, pick, Progression_RewardSpecialEffect(pick), Progression_RewardSpecialPower(pick));
+            }
+        }
+    }
+}
+
+void Run_Play(RunState* run, uint64_t seed, const RunPolicy* policy, RunResult* result) {
+    Run_PlayRecorded(run, seed, policy, result, NULL);
+}
+
+void Run_PlayRecorded(RunState* run, uint64_t seed, const RunPolicy* policy, RunResult* result, ReplayLog* log) {
+    bool check_hashes = run->check_hashes;
+    memset(run, 0, sizeof(*run));
+    memset(result, 0, sizeof(*result));
+    run->check_hashes = check_hashes;
+    run->log = log;
+    Replay_Begin(log, seed);
+    for (int s = 0; s < RNG_STREAM_COUNT; s++) Rng_Init(&run->rng[s], seed, (RngStream)s);
+
+    Progression_ResetPlayer(&run->player);
+    for (int i = 0; i < STARTING_ATTACK_CARDS; i++) AddToDraw(run, Attack, None, BASIC_ATTACK_POWER);
+    for (int i = 0; i < STARTING_HEAL_CARDS; i++) AddToDraw(run, Heal, None, BASIC_HEAL_POWER);
+    for (int i = 0; i < STARTING_SHIELD_CARDS; i++) AddToDraw(run, Shield, None, BASIC_SHIELD_POWER);
+    ShuffleDraw(run);
+
+    for (run->level = 1; run->level <= RUN_MAX_LEVEL && Levels_Get(run->level); run->level++) {
+        if (run->level > 1) GatherAllCards(run);
+        run->player.checkpoint_level = run->level;
+        run->player.shield = PLAYER_START_SHIELD;
+        LoadEncounter(run, run->level); // After the shield reset so the combat hash sees it
+        CheckHashes(run, result);
+        run->turn = 0;
+        Replay_Record(run->log, REPLAY_LEVEL, run->level, 0, 0);
+
+        bool cleared = false;
+        while (!cleared && run->turn < RUN_TURN_LIMIT) {
+            cleared = PlayTurn(run, policy, result);
+            if (!cleared && run->player.health <= 0) break;
+        }
+        result->turns[run->level] = run->turn + (cleared ? 1 : 0);
+
+        if (!cleared) {
+            // Running out of turns isn't a death the game could record
+            if (run->player.health <= 0) Replay_Record(run->log, REPLAY_DEATH, run->level, 0, 0);
+            result->death_level = run->level;
+            return;
+        }
+        result->levels_cleared++;
+        if (run->level < RUN_MAX_LEVEL && Levels_Get(run->level + 1)) GrantReward(run, policy);
+    }
+    result->won = true;
+    Replay_Record(run->log, REPLAY_WIN, 0, 0, 0);
+}
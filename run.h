@@ -0,0 +1,83 @@
+// Headless campaign runner: plays a full 9-level run with the real combat and progression rules.
+// Used by the batch simulator (sim.c); never touches CProcessing.
+#pragma once
+#include <stdbool.h>
+#include <stdint.h>
+#include "player.h"
+#include "levels.h"
+#include "combat.h"
+#include "progression.h"
+#include "rng.h"
+#include "replay.h"
+
+#define RUN_MAX_LEVEL 9
+#define RUN_MAX_CARDS 32 // Power of two, so draw pile positions wrap with a mask
+#define RUN_MAX_HAND 7
+#define RUN_MAX_ENEMIES ENCOUNTER_MAX_ENEMIES
+#define RUN_CARDS_PER_TURN_CAP 3 // Turn auto-ends after 3 plays, same as Game_Update
+#define RUN_TURN_LIMIT 200       // A level that drags on this long counts as a loss
+
+// A card as the rules see it: no position, animation or text.
+typedef struct {
+    CardType type;
+    CardEffect effect;
+    int power;
+} RunCard;
+
+// The complete state of one run. Holds pointers into itself (combat), so never copy it by value.
+typedef struct RunState {
+    Player player;
+
+    RunCard draw[RUN_MAX_CARDS]; // Draw pile ring, top card at draw[draw_head] (same layout as Deck)
+    int draw_head;
+    int draw_size;
+    RunCard discard[RUN_MAX_CARDS];
+    int discard_size;
+    RunCard hand[RUN_MAX_HAND];
+    int hand_size;
+    uint64_t hand_hash; // Sum of Zobrist_CardKey over hand[], kept up to date as cards come and go
+
+    Encounter encounter; // This run's own enemy instances; the level templates are never touched
+    CombatState combat;
+
+    int level;
+    int turn;
+    int played_cards;
+    Rng rng[RNG_STREAM_COUNT]; // One stream per subsystem, all derived from the run seed
+    ReplayLog* log;            // Receives every deal and decision when set (Run_PlayRecorded)
+    bool check_hashes;         // Set by the caller (kept across runs): compare the incremental hashes
+                               // against a full recompute after every change, see hash_mismatches
+} RunState;
+
+// Decision callbacks. Any callback may be NULL, in which case the run picks the first legal option.
+// Callbacks must not change the run, but may draw random numbers through Run_RandomRange.
+typedef struct RunPolicy {
+    const char* name;
+    // Returns the hand index to play and writes the enemy target, or returns -1 to end the turn.
+    int (*choose_card)(RunState* run, int* target, void* ctx);
+    // Returns the card reward type to take after a normal level (Attack, Heal or Shield).
+    CardType (*choose_reward)(RunState* run, void* ctx);
+    // Returns the index into options of the buff to take after a boss level.
+    int (*choose_buff)(RunState* run, const BuffType options[BOSS_BUFF_OPTIONS], void* ctx);
+    void* ctx;
+    // Frees ctx when the policy is released. NULL if ctx is not owned by the policy.
+    void (*release)(void* ctx);
+} RunPolicy;
+
+// Outcome of one run.
+typedef struct RunResult {
+    bool won;
+    int death_level;                  // Level the player died on, 0 if the run was won
+    int turns[RUN_MAX_LEVEL + 1];     // Turns spent on each level (index 1-9)
+    int levels_cleared;
+    int hash_mismatches;              // Failed hash checks, always 0 unless run->check_hashes is set
+} RunResult;
+
+// Plays one complete run from a fresh player and starting deck, seeded with seed.
+void Run_Play(RunState* run, uint64_t seed, const RunPolicy* policy, RunResult* result);
+
+// Same as Run_Play, and also records the run into log (see replay.h) for later playback.
+void Run_PlayRecorded(RunState* run, uint64_t seed, const RunPolicy* policy, RunResult* result, ReplayLog* log);
+
+// Returns a uniformly distributed integer in [lo, hi] from one of the run's streams.
+int Run_RandomRange(RunState* run, RngStream stream, int lo, int hi);
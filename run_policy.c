@@ -0,0 +1,209 @@
+// @file run_policy.c
+// @brief Simple hand-written policies for balance sweeps. They read the run but never change it.
+
+#include "run_policy.h"
+#include "ai.h"
+#include <stdlib.h>
+#include <string.h>
+
+// --- Shared helpers ---
+
+// Damage an attack card of the given power would deal before enemy shields.
+static int AttackDamage(const Player* player, int power) {
+    int damage = power + player->attack_bonus;
+    if (player->has_attack_boost_35) damage = (int)(damage * 1.35f);
+    return damage;
+}
+
+static int HealAmount(const Player* player, int power) {
+    int amount = power + player->heal_bonus;
+    if (player->has_heal_boost_35) amount = (int)(amount * 1.35f);
+    return amount;
+}
+
+static int ShieldAmount(const Player* player, int power) {
+    int amount = power + player->shield_bonus;
+    if (player->has_shield_boost) amount = (int)(amount * 1.25f);
+    if (player->has_shield_boost_35) amount = (int)(amount * 1.35f);
+    return amount;
+}
+
+// Health damage a hit of the given size does to an enemy after its shield.
+static int EffectiveDamage(const Encounter* enc, int i, int damage) {
+    int through = damage - enc->shield[i];
+    if (through < 0) through = 0;
+    return (through > enc->health[i]) ? enc->health[i] : through;
+}
+
+// --- Random policy ---
+
+static int RandomChooseCard(RunState* run, int* target, void* ctx) {
+    (void)ctx;
+    int living[RUN_MAX_ENEMIES];
+    int living_count = 0;
+    for (int i = 0; i < run->encounter.enemy_count; i++) {
+        if (run->encounter.alive[i]) living[living_count++] = i;
+    }
+    *target = living_count > 0 ? living[Run_RandomRange(run, RNG_STREAM_AI, 0, living_count - 1)] : -1;
+    if (run->hand_size <= 0) return -1;
+    return Run_RandomRange(run, RNG_STREAM_AI, 0, run->hand_size - 1);
+}
+
+static CardType RandomChooseReward(RunState* run, void* ctx) {
+    (void)ctx;
+    return (CardType)Run_RandomRange(run, RNG_STREAM_REWARD, Attack, Shield);
+}
+
+static int RandomChooseBuff(RunState* run, const BuffType options[BOSS_BUFF_OPTIONS], void* ctx) {
+    (void)options; (void)ctx;
+    return Run_RandomRange(run, RNG_STREAM_REWARD, 0, BOSS_BUFF_OPTIONS - 1);
+}
+
+RunPolicy RunPolicy_Random(void) {
+    RunPolicy policy = { "random", RandomChooseCard, RandomChooseReward, RandomChooseBuff, NULL, NULL };
+    return policy;
+}
+
+// --- Greedy policy ---
+
+static int GreedyChooseCard(RunState* run, int* target, void* ctx) {
+    (void)ctx;
+    const Player* player = &run->player;
+    const Encounter* enc = &run->encounter;
+
+    int incoming = 0;
+    int best_target = -1;
+    for (int i = 0; i < enc->enemy_count; i++) {
+        if (!enc->alive[i]) continue;
+        incoming += enc->attack[i];
+        if (best_target < 0 || enc->attack[i] > enc->attack[best_target]) best_target = i;
+    }
+
+    int best_index = -1;
+    int best_target_for_card = best_target;
+    float best_score = -1.0f;
+
+    for (int c = 0; c < run->hand_size; c++) {
+        const RunCard* card = &run->hand[c];
+        float score = 0.0f;
+        int card_target = best_target;
+
+        if (card->type == Attack && card->effect == CLEAVE) {
+            int damage = AttackDamage(player, card->power);
+            for (int i = 0; i < enc->enemy_count; i++) {
+                if (!enc->alive[i]) continue;
+                score += (float)EffectiveDamage(enc, i, damage);
+                if (EffectiveDamage(enc, i, damage) >= enc->health[i]) score += 20.0f + 2.0f * (float)enc->attack[i];
+            }
+        }
+        else if (card->type == Attack) {
+            // Prefer a kill on the hardest hitter, otherwise chip the hardest hitter
+            int damage = AttackDamage(player, card->power);
+            float best_attack_score = -1.0f;
+            for (int i = 0; i < enc->enemy_count; i++) {
+                if (!enc->alive[i]) continue;
+                float s = (float)EffectiveDamage(enc, i, damage);
+                if (EffectiveDamage(enc, i, damage) >= enc->health[i]) s += 20.0f + 2.0f * (float)enc->attack[i];
+                if (s > best_attack_score) { best_attack_score = s; card_target = i; }
+            }
+            score = best_attack_score;
+        }
+        else if (card->type == Heal) {
+            int missing = player->max_health - player->health;
+            int heal = HealAmount(player, card->power);
+            score = (float)(heal < missing ? heal : missing);
+            score *= (player->health * 2 < player->max_health) ? 1.5f : 0.8f;
+        }
+        else if (card->type == Shield) {
+            int needed = incoming - player->shield;
+            int gain = ShieldAmount(player, card->power);
+            if (needed < 0) needed = 0;
+            score = 1.2f * (float)(gain < needed ? gain : needed);
+        }
+
+        if (score > best_score) {
+            best_score = score;
+            best_index = c;
+            best_target_for_card = card_target;
+        }
+    }
+
+    *target = best_target_for_card;
+    return best_index;
+}
+
+static CardType GreedyChooseReward(RunState* run, void* ctx) {
+    (void)ctx;
+    // Spread the bonuses: take whichever type has the smallest bonus, attack first on ties
+    const Player* p = &run->player;
+    if (p->attack_bonus <= p->heal_bonus && p->attack_bonus <= p->shield_bonus) return Attack;
+    if (p->heal_bonus <= p->shield_bonus) return Heal;
+    return Shield;
+}
+
+static int GreedyChooseBuff(RunState* run, const BuffType options[BOSS_BUFF_OPTIONS], void* ctx) {
+    (void)run; (void)ctx;
+    // Lifesteal and the 35% attack boost are listed first at their tiers
+    for (int i = 0; i < BOSS_BUFF_OPTIONS; i++) {
+        if (options[i] == BUFF_LIFESTEAL || options[i] == BUFF_ATTACK_BOOST_35) return i;
+    }
+    return 0;
+}
+
+RunPolicy RunPolicy_Greedy(void) {
+    RunPolicy policy = { "greedy", GreedyChooseCard, GreedyChooseReward, GreedyChooseBuff, NULL, NULL };
+    return policy;
+}
+
+// --- Search policy ---
+
+#define SEARCH_POLICY_NODES 20000 // Per decision; enough to finish almost every turn
+
+typedef struct {
+    AiSearch* search;
+    long long max_nodes;
+} SearchPolicy;
+
+static int SearchChooseCard(RunState* run, int* target, void* ctx) {
+    SearchPolicy* policy = (SearchPolicy*)ctx;
+    if (!policy || !policy->search) return GreedyChooseCard(run, target, NULL); // Out of memory at creation
+
+    AiBudget budget = { policy->max_nodes, 0.0 };
+    AiMove move = Ai_FindBestMove(policy->search, &run->player, &run->encounter,
+        run->hand, run->hand_size, run->played_cards, budget);
+    *target = move.target;
+    return move.hand_index;
+}
+
+static void SearchRelease(void* ctx) {
+    SearchPolicy* policy = (SearchPolicy*)ctx;
+    if (!policy) return;
+    Ai_Destroy(policy->search);
+    free(policy);
+}
+
+RunPolicy RunPolicy_Search(long long max_nodes) {
+    RunPolicy policy = { "search", SearchChooseCard, GreedyChooseReward, GreedyChooseBuff, NULL, SearchRelease };
+    SearchPolicy* ctx = calloc(1, sizeof(SearchPolicy));
+    if (ctx) {
+        ctx->search = Ai_Create(AI_TT_BITS_DEFAULT);
+        ctx->max_nodes = max_nodes;
+    }
+    policy.ctx = ctx;
+    return policy;
+}
+
+bool RunPolicy_FromName(const char* name, RunPolicy* out) {
+    if (!name || !out) return false;
+    if (strcmp(name, "random") == 0) { *out = RunPolicy_Random(); return true; }
+    if (strcmp(name, "greedy") == 0) { *out = RunPolicy_Greedy(); return true; }
+    if (strcmp(name, "search") == 0) { *out = RunPolicy_Search(SEARCH_POLICY_NODES); return true; }
+    return false;
+}
+
+void RunPolicy_Release(RunPolicy* policy) {
+    if (!policy) return;
+    if (policy->release) policy->release(policy->ctx);
+    policy->ctx = NULL;
+    policy->release = NULL;
+}
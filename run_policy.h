@@ -0,0 +1,21 @@
+// Built-in decision policies for the headless run simulator.
+#pragma once
+#include "run.h"
+
+// Plays a random legal card at a random living enemy and takes random rewards.
+RunPolicy RunPolicy_Random(void);
+
+// Plays the card with the best immediate value (kills first, then damage, heal and shield as needed).
+RunPolicy RunPolicy_Greedy(void);
+
+// Plays the best line found by the turn solver (ai.h) within a fixed node budget per decision, so
+// results stay reproducible. Rewards and buffs are picked like the greedy policy. Each policy owns
+// its solver: create one per thread and free it with RunPolicy_Release.
+RunPolicy RunPolicy_Search(long long max_nodes);
+
+// Looks up a built-in policy by name ("random", "greedy", "search"). Each call returns a fresh
+// policy; release it with RunPolicy_Release. Returns false if the name is unknown.
+bool RunPolicy_FromName(const char* name, RunPolicy* out);
+
+// Frees anything the policy owns.
+void RunPolicy_Release(RunPolicy* policy);
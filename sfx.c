@@ -1,41 +1,33 @@
 #include "sfx.h"
-#include <stdio.h>
+#include "assets.h"
 
-// Static variables to hold the sound data
-static CP_Sound sfx_card_draw = NULL;
-static CP_Sound sfx_heal = NULL;
-static CP_Sound sfx_shield = NULL;
+static const char* const sfx_paths[] = {
+    "Assets/card_in.ogg",   // SFX_CARD_DRAW
+    "Assets/heal_sfx.ogg",  // SFX_HEAL
+    "Assets/shield_sfx.ogg" // SFX_SHIELD
+};
+#define SFX_COUNT ((int)(sizeof(sfx_paths) / sizeof(sfx_paths[0])))
 
-void Audio_Init(void) {
-    // Load sounds once at startup
-    // Ensure filenames match exactly what you uploaded
-    sfx_card_draw = CP_Sound_Load("Assets/card_in.ogg");
-    sfx_heal = CP_Sound_Load("Assets/heal_sfx.ogg");
-    sfx_shield = CP_Sound_Load("Assets/shield_sfx.ogg");
+// Handles to the sound data, held between Audio_Init and Audio_Exit
+static AssetId sfx_ids[SFX_COUNT];
 
-    // Error checking (optional but good for debugging)
-    if (!sfx_card_draw) printf("Warning: card_in.ogg not found\n");
-    if (!sfx_heal)      printf("Warning: heal_sfx.ogg not found\n");
-    if (!sfx_shield)    printf("Warning: shield_sfx.ogg not found\n");
+void Audio_Preload(void) {
+    for (int i = 0; i < SFX_COUNT; i++) Asset_Preload(ASSET_SOUND, sfx_paths[i]);
 }
 
-void Audio_Play(SoundType type) {
-    switch (type) {
-    case SFX_CARD_DRAW:
-        if (sfx_card_draw) CP_Sound_Play(sfx_card_draw);
-        break;
-    case SFX_HEAL:
-        if (sfx_heal) CP_Sound_Play(sfx_heal);
-        break;
-    case SFX_SHIELD:
-        if (sfx_shield) CP_Sound_Play(sfx_shield);
-        break;
+void Audio_Init(void) {
+    // The registry hands back the already loaded sounds; missing files are reported there
+    for (int i = 0; i < SFX_COUNT; i++) {
+        if (sfx_ids[i] == ASSET_NONE) sfx_ids[i] = Asset_Acquire(ASSET_SOUND, sfx_paths[i]);
     }
 }
 
+void Audio_Play(SoundType type) {
+    if ((int)type < 0 || (int)type >= SFX_COUNT) return;
+    CP_Sound sound = Asset_Sound(sfx_ids[type]);
+    if (sound) CP_Sound_Play(sound);
+}
+
 void Audio_Exit(void) {
-    // Clean up memory
-    CP_Sound_Free(sfx_card_draw);
-    CP_Sound_Free(sfx_heal);
-    CP_Sound_Free(sfx_shield);
-}
\ No newline at end of file
+    for (int i = 0; i < SFX_COUNT; i++) Asset_Release(&sfx_ids[i]);
+}
@@ -9,11 +9,14 @@ typedef enum {
     SFX_SHIELD
 } SoundType;
 
-// Initializes the audio system and loads all sound assets.
+// Queues the sound effects for the asset preloader (see assets.h).
+void Audio_Preload(void);
+
+// Initializes the audio system and acquires all sound assets.
 void Audio_Init(void);
 
 // Plays a specific sound effect based on the provided SoundType enum.
 void Audio_Play(SoundType type);
 
-// Cleans up audio resources and frees memory.
+// Releases the sound assets acquired by Audio_Init.
 void Audio_Exit(void);
\ No newline at end of file
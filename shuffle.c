@@ -0,0 +1,205 @@
+// @file shuffle.c
+// @brief Vectorized draw generation for Fisher-Yates shuffles.
+//
+// Shuffle_Draws vectorizes along one deck (lane l holds draw t + l); Shuffle_Batch vectorizes across
+// decks (lane l holds deck l's draw t), so the batch needs no per-deck setup beyond loading a lane.
+// Draw t of a shuffle (t = 0 for the last position) is Rng_At(key, counter + t) reduced to
+// [0, size - 1 - t] by a multiply-shift on its top 32 bits, the same as Rng_Range. SSE2 and AVX2
+// have no 64-bit low multiply, so the SplitMix constants are applied as three 32x32->64 products.
+
+#include "shuffle.h"
+#include <stddef.h>
+
+#if defined(__AVX2__)
+#define SHUFFLE_AVX2 1
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#define SHUFFLE_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#define RNG_GAMMA 0x9E3779B97F4A7C15ull
+#define MIX_C1 0xBF58476D1CE4E5B9ull
+#define MIX_C2 0x94D049BB133111EBull
+
+#if defined(SHUFFLE_AVX2)
+// Low 64 bits of a * c in each lane.
+static __m256i Mul64(__m256i a, uint64_t c) {
+    const __m256i c_lo = _mm256_set1_epi64x((long long)(c & 0xFFFFFFFFull));
+    const __m256i c_hi = _mm256_set1_epi64x((long long)(c >> 32));
+    __m256i lo = _mm256_mul_epu32(a, c_lo);
+    __m256i cross = _mm256_add_epi64(_mm256_mul_epu32(_mm256_srli_epi64(a, 32), c_lo), _mm256_mul_epu32(a, c_hi));
+    return _mm256_add_epi64(lo, _mm256_slli_epi64(cross, 32));
+}
+
+static __m256i Mix(__m256i z) {
+    z = Mul64(_mm256_xor_si256(z, _mm256_srli_epi64(z, 30)), MIX_C1);
+    z = Mul64(_mm256_xor_si256(z, _mm256_srli_epi64(z, 27)), MIX_C2);
+    return _mm256_xor_si256(z, _mm256_srli_epi64(z, 31));
+}
+#elif defined(SHUFFLE_SSE2)
+static __m128i Mul64(__m128i a, uint64_t c) {
+    const __m128i c_lo = _mm_set1_epi64x((long long)(c & 0xFFFFFFFFull));
+    const __m128i c_hi = _mm_set1_epi64x((long long)(c >> 32));
+    __m128i lo = _mm_mul_epu32(a, c_lo);
+    __m128i cross = _mm_add_epi64(_mm_mul_epu32(_mm_srli_epi64(a, 32), c_lo), _mm_mul_epu32(a, c_hi));
+    return _mm_add_epi64(lo, _mm_slli_epi64(cross, 32));
+}
+
+static __m128i Mix(__m128i z) {
+    z = Mul64(_mm_xor_si128(z, _mm_srli_epi64(z, 30)), MIX_C1);
+    z = Mul64(_mm_xor_si128(z, _mm_srli_epi64(z, 27)), MIX_C2);
+    return _mm_xor_si128(z, _mm_srli_epi64(z, 31));
+}
+#endif
+
+void Shuffle_Draws(Rng* rng, int size, uint8_t* swaps) {
+    if (size > SHUFFLE_MAX_SIZE) size = SHUFFLE_MAX_SIZE;
+    if (size < 1) return;
+    swaps[0] = 0;
+    int draws = size - 1;
+    int t = 0;
+
+#if defined(SHUFFLE_AVX2)
+    // Lane l holds draw t + l: pre-mix state key + gamma * (counter + t + l + 1), span size - t - l
+    uint64_t first = rng->key + RNG_GAMMA * (rng->counter + 1);
+    __m256i state = _mm256_set_epi64x((long long)(first + 3 * RNG_GAMMA), (long long)(first + 2 * RNG_GAMMA),
+        (long long)(first + RNG_GAMMA), (long long)first);
+    __m256i span = _mm256_set_epi64x(size - 3, size - 2, size - 1, size);
+    const __m256i state_step = _mm256_set1_epi64x((long long)(4 * RNG_GAMMA));
+    const __m256i span_step = _mm256_set1_epi64x(4);
+    for (; t + 4 <= draws; t += 4) {
+        __m256i top = _mm256_srli_epi64(Mix(state), 32);
+        __m256i j = _mm256_srli_epi64(_mm256_mul_epu32(top, span), 32);
+        uint64_t out[4];
+        _mm256_storeu_si256((__m256i*)out, j);
+        for (int l = 0; l < 4; l++) swaps[size - 1 - (t + l)] = (uint8_t)out[l];
+        state = _mm256_add_epi64(state, state_step);
+        span = _mm256_sub_epi64(span, span_step);
+    }
+#elif defined(SHUFFLE_SSE2)
+    uint64_t first = rng->key + RNG_GAMMA * (rng->counter + 1);
+    __m128i state = _mm_set_epi64x((long long)(first + RNG_GAMMA), (long long)first);
+    __m128i span = _mm_set_epi64x(size - 1, size);
+    const __m128i state_step = _mm_set1_epi64x((long long)(2 * RNG_GAMMA));
+    const __m128i span_step = _mm_set1_epi64x(2);
+    for (; t + 2 <= draws; t += 2) {
+        __m128i top = _mm_srli_epi64(Mix(state), 32);
+        __m128i j = _mm_srli_epi64(_mm_mul_epu32(top, span), 32);
+        uint64_t out[2];
+        _mm_storeu_si128((__m128i*)out, j);
+        swaps[size - 1 - t] = (uint8_t)out[0];
+        swaps[size - 2 - t] = (uint8_t)out[1];
+        state = _mm_add_epi64(state, state_step);
+        span = _mm_sub_epi64(span, span_step);
+    }
+#endif
+
+    // Leftover draws (all of them on the scalar path)
+    rng->counter += (uint64_t)t;
+    for (; t < draws; t++) {
+        int i = size - 1 - t;
+        swaps[i] = (uint8_t)Rng_Range(rng, 0, i);
+    }
+}
+
+void Shuffle_Indices(uint8_t* cards, int size, Rng* rng) {
+    if (!cards || !rng || size < 2) return;
+    if (size > SHUFFLE_MAX_SIZE) size = SHUFFLE_MAX_SIZE;
+    uint8_t swaps[SHUFFLE_MAX_SIZE];
+    Shuffle_Draws(rng, size, swaps);
+    for (int i = size - 1; i > 0; i--) {
+        uint8_t temp = cards[i];
+        cards[i] = cards[swaps[i]];
+        cards[swaps[i]] = temp;
+    }
+}
+
+#if defined(SHUFFLE_AVX2) || defined(SHUFFLE_SSE2)
+#if defined(SHUFFLE_AVX2)
+#define BATCH_LANES 4
+#else
+#define BATCH_LANES 2
+#endif
+
+// Shuffles BATCH_LANES decks at once, one per lane. On step t every lane draws the partner of its
+// position size - 1 - t and swaps; a lane whose deck is already done sits the remaining steps out.
+static void ShuffleLanes(uint8_t* const* cards, const int* sizes, Rng* const* rngs) {
+    uint64_t first[BATCH_LANES];
+    uint64_t start_span[BATCH_LANES];
+    int draws[BATCH_LANES];
+    int steps = 0;
+    for (int l = 0; l < BATCH_LANES; l++) {
+        int size = sizes[l] > SHUFFLE_MAX_SIZE ? SHUFFLE_MAX_SIZE : sizes[l];
+        draws[l] = size > 1 ? size - 1 : 0;
+        first[l] = rngs[l]->key + RNG_GAMMA * (rngs[l]->counter + 1);
+        start_span[l] = (uint64_t)(size > 0 ? size : 0);
+        if (draws[l] > steps) steps = draws[l];
+    }
+
+#if defined(SHUFFLE_AVX2)
+    __m256i state = _mm256_loadu_si256((const __m256i*)first);
+    __m256i span = _mm256_loadu_si256((const __m256i*)start_span);
+    const __m256i state_step = _mm256_set1_epi64x((long long)RNG_GAMMA);
+    const __m256i span_step = _mm256_set1_epi64x(1);
+#else
+    __m128i state = _mm_loadu_si128((const __m128i*)first);
+    __m128i span = _mm_loadu_si128((const __m128i*)start_span);
+    const __m128i state_step = _mm_set1_epi64x((long long)RNG_GAMMA);
+    const __m128i span_step = _mm_set1_epi64x(1);
+#endif
+    for (int t = 0; t < steps; t++) {
+        uint64_t out[BATCH_LANES];
+#if defined(SHUFFLE_AVX2)
+        __m256i top = _mm256_srli_epi64(Mix(state), 32);
+        _mm256_storeu_si256((__m256i*)out, _mm256_srli_epi64(_mm256_mul_epu32(top, span), 32));
+        state = _mm256_add_epi64(state, state_step);
+        span = _mm256_sub_epi64(span, span_step);
+#else
+        __m128i top = _mm_srli_epi64(Mix(state), 32);
+        _mm_storeu_si128((__m128i*)out, _mm_srli_epi64(_mm_mul_epu32(top, span), 32));
+        state = _mm_add_epi64(state, state_step);
+        span = _mm_sub_epi64(span, span_step);
+#endif
+        for (int l = 0; l < BATCH_LANES; l++) {
+            if (t >= draws[l]) continue;
+            uint8_t* deck = cards[l];
+            int i = draws[l] - t;
+            uint8_t temp = deck[i];
+            deck[i] = deck[out[l]];
+            deck[out[l]] = temp;
+        }
+    }
+    for (int l = 0; l < BATCH_LANES; l++) rngs[l]->counter += (uint64_t)draws[l];
+}
+#endif
+
+void Shuffle_Batch(uint8_t* decks, int stride, const int* sizes, Rng* rngs, int count) {
+    if (!decks || !sizes || !rngs) return;
+    int k = 0;
+#if defined(SHUFFLE_AVX2) || defined(SHUFFLE_SSE2)
+    for (; k + BATCH_LANES <= count; k += BATCH_LANES) {
+        uint8_t* cards[BATCH_LANES];
+        Rng* lane_rngs[BATCH_LANES];
+        for (int l = 0; l < BATCH_LANES; l++) {
+            cards[l] = decks + (size_t)(k + l) * (size_t)stride;
+            lane_rngs[l] = &rngs[k + l];
+        }
+        ShuffleLanes(cards, &sizes[k], lane_rngs);
+    }
+#endif
+    // Leftover decks (all of them on the scalar path)
+    for (; k < count; k++) {
+        Shuffle_Indices(decks + (size_t)k * (size_t)stride, sizes[k], &rngs[k]);
+    }
+}
+
+const char* Shuffle_Path(void) {
+#if defined(SHUFFLE_AVX2)
+    return "avx2";
+#elif defined(SHUFFLE_SSE2)
+    return "sse2";
+#else
+    return "scalar";
+#endif
+}
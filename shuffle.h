@@ -0,0 +1,25 @@
+// Fisher-Yates shuffles over small index decks, with the random draws generated 4 (AVX2) or
+// 2 (SSE2) at a time: along one deck for a single shuffle, across decks for a batch. The generator in rng.h is counter-based, so every draw of a shuffle can be
+// computed independently; the swaps themselves move single bytes. Every path consumes the stream
+// exactly like a loop of Rng_Range calls, so results never depend on the instruction set.
+#pragma once
+#include <stdint.h>
+#include "rng.h"
+
+#define SHUFFLE_MAX_SIZE 64 // Largest deck a single shuffle handles
+
+// Fills swaps[i] (1 <= i < size) with the partner of position i in a back-to-front Fisher-Yates,
+// i.e. Rng_Range(rng, 0, i) for i = size-1 down to 1, and advances rng past those draws.
+// swaps[0] is set to 0. size is clamped to SHUFFLE_MAX_SIZE.
+void Shuffle_Draws(Rng* rng, int size, uint8_t* swaps);
+
+// Shuffles size byte indices in place.
+void Shuffle_Indices(uint8_t* cards, int size, Rng* rng);
+
+// Shuffles count index decks stored stride bytes apart; deck k holds sizes[k] entries and draws
+// from rngs[k]. Decks go 4 (AVX2) or 2 (SSE2) at a time, one per lane, every lane stepping the same
+// position together; the result is the same as calling Shuffle_Indices on each deck in turn.
+void Shuffle_Batch(uint8_t* decks, int stride, const int* sizes, Rng* rngs, int count);
+
+// Name of the code path the draws were built with ("avx2", "sse2" or "scalar").
+const char* Shuffle_Path(void);
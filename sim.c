@@ -0,0 +1,344 @@
+// @file sim.c
+// @brief Batch Monte Carlo simulator. Plays N headless 9-level runs and reports balance statistics.
+//
+// Standalone executable; it links only the render-free modules:
+//   sim.c run.c run_policy.c ai.c combat.c aoe.c zobrist.c progression.c levels.c workpool.c platform.c rng.c
+//   shuffle.c replay.c eventbus.c
+// (plus -pthread -lm on POSIX).
+//
+// Runs are sharded over a work-stealing pool. Every run is seeded from (seed, run index) and each
+// worker owns its RunState and stats, so results are bit-identical for any --threads value.
+//
+// Usage: sim [--runs N] [--seed S] [--policy random|greedy|search] [--threads N] [--levels FILE]
+//            [--record DIR]               (writes DIR/run_<index>.rpl for every run)
+//            [--check-hash]               (checks the incremental Zobrist hashes against full
+//                                          recomputes after every change; exits 1 on a mismatch)
+//        sim --replay FILE... [--speed max|trace] [--levels FILE]
+//                                         (plays recorded runs back through the current rules)
+//        sim --shuffle-check [--seed S]   (uniformity and throughput of the batch shuffler)
+
+#include "run.h"
+#include "run_policy.h"
+#include "workpool.h"
+#include "platform.h"
+#include "rng.h"
+#include "shuffle.h"
+#include "replay.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Aggregated results over many runs.
+typedef struct {
+    long long runs;
+    long long wins;
+    long long reached[RUN_MAX_LEVEL + 1];     // Runs that started each level
+    long long cleared[RUN_MAX_LEVEL + 1];     // Runs that cleared each level
+    long long turns_cleared[RUN_MAX_LEVEL + 1]; // Total turns spent on cleared levels
+    long long deaths[RUN_MAX_LEVEL + 1];      // Death-level histogram
+    long long hash_mismatches;                // Only counted with --check-hash
+} SimStats;
+
+// Per-worker state: its own run, policy instance and partial statistics.
+typedef struct {
+    RunState run;
+    RunPolicy policy;
+    SimStats stats;
+    ReplayLog log;
+} SimWorker;
+
+typedef struct {
+    SimWorker* workers;
+    uint64_t seed;
+    const char* record_dir; // NULL unless --record
+} SimJob;
+
+static void AccumulateResult(SimStats* stats, const RunResult* result) {
+    stats->runs++;
+    if (result->won) stats->wins++;
+    for (int level = 1; level <= RUN_MAX_LEVEL; level++) {
+        if (level <= result->levels_cleared + 1) {
+            stats->reached[level]++;
+        }
+        if (level <= result->levels_cleared) {
+            stats->cleared[level]++;
+            stats->turns_cleared[level] += result->turns[level];
+        }
+    }
+    if (!result->won) stats->deaths[result->death_level]++;
+    stats->hash_mismatches += result->hash_mismatches;
+}
+
+static void MergeStats(SimStats* into, const SimStats* from) {
+    into->runs += from->runs;
+    into->wins += from->wins;
+    into->hash_mismatches += from->hash_mismatches;
+    for (int level = 0; level <= RUN_MAX_LEVEL; level++) {
+        into->reached[level] += from->reached[level];
+        into->cleared[level] += from->cleared[level];
+        into->turns_cleared[level] += from->turns_cleared[level];
+        into->deaths[level] += from->deaths[level];
+    }
+}
+
+// Work-pool callback: plays runs [begin, end) on the worker's private state.
+static void PlayRuns(uint32_t begin, uint32_t end, int worker, void* ctx) {
+    SimJob* job = (SimJob*)ctx;
+    SimWorker* w = &job->workers[worker];
+    for (uint32_t i = begin; i < end; i++) {
+        RunResult result;
+        uint64_t run_seed = Rng_SeedFor(job->seed, (uint64_t)i);
+        if (job->record_dir) {
+            char path[512];
+            Run_PlayRecorded(&w->run, run_seed, &w->policy, &result, &w->log);
+            snprintf(path, sizeof(path), "%s/run_%06u.rpl", job->record_dir, i);
+            if (!Replay_Save(&w->log, path)) printf("could not write %s\n", path);
+        }
+        else Run_Play(&w->run, run_seed, &w->policy, &result);
+        AccumulateResult(&w->stats, &result);
+    }
+}
+
+static void PrintStats(const SimStats* stats, const char* policy_name, uint64_t seed, int threads, double seconds) {
+    printf("policy: %s  runs: %lld  seed: %llu  threads: %d\n", policy_name, stats->runs, (unsigned long long)seed, threads);
+    printf("win rate: %.2f%%\n", stats->runs ? 100.0 * (double)stats->wins / (double)stats->runs : 0.0);
+    printf("\nlevel   reached    cleared  avg turns   deaths\n");
+    for (int level = 1; level <= RUN_MAX_LEVEL; level++) {
+        double avg_turns = stats->cleared[level] ? (double)stats->turns_cleared[level] / (double)stats->cleared[level] : 0.0;
+        printf("%5d %9lld %10lld %10.2f %8lld\n", level, stats->reached[level], stats->cleared[level], avg_turns, stats->deaths[level]);
+    }
+    printf("\n%.3f s (%.0f runs/s)\n", seconds, seconds > 0.0 ? (double)stats->runs / seconds : 0.0);
+}
+
+static void PrintUsage(void) {
+    printf("Usage: sim [--runs N] [--seed S] [--policy random|greedy|search] [--threads N] [--levels FILE] [--record DIR]\n");
+    printf("           [--check-hash]\n");
+    printf("       sim --replay FILE... [--speed max|trace] [--levels FILE]\n");
+    printf("       sim --shuffle-check [--seed S]\n");
+}
+
+// --- Replay playback ---
+
+// Plays every log back and reports the outcome, or where the current rules stop agreeing with it.
+static int RunReplays(char** paths, int count, bool trace) {
+    ReplayLog log;
+    memset(&log, 0, sizeof(log));
+    int ok = 0, drifted = 0, unreadable = 0;
+    long long records = 0;
+    double start = Platform_Seconds();
+
+    for (int i = 0; i < count; i++) {
+        if (!Replay_Load(&log, paths[i])) {
+            printf("%s: not a replay file\n", paths[i]);
+            unreadable++;
+            continue;
+        }
+        if (trace) printf("%s (seed %llu, %d records)\n", paths[i], (unsigned long long)log.seed, log.count);
+        ReplayResult result;
+        bool clean = Replay_Play(&log, &result, trace ? stdout : NULL);
+        records += log.count;
+
+        char outcome[48];
+        if (result.won) snprintf(outcome, sizeof(outcome), "won");
+        else if (result.death_level > 0) snprintf(outcome, sizeof(outcome), "died on level %d", result.death_level);
+        else snprintf(outcome, sizeof(outcome), "unfinished");
+        printf("%s: %s  cleared %d  deaths %d  turns %d  plays %d", paths[i], outcome,
+            result.levels_cleared, result.deaths, result.turns, result.plays);
+        if (clean) { printf("  ok\n"); ok++; }
+        else { printf("  DRIFT at record %d (%s)\n", result.drift_at, result.drift); drifted++; }
+    }
+    double seconds = Platform_Seconds() - start;
+    Replay_Free(&log);
+
+    printf("\nreplays: %d  ok: %d  drift: %d  unreadable: %d  records: %lld  %.3f ms\n",
+        count, ok, drifted, unreadable, records, seconds * 1000.0);
+    return (drifted || unreadable) ? 1 : 0;
+}
+
+// --- Shuffle check ---
+
+#define CHECK_BATCH 256         // Decks shuffled per Shuffle_Batch call
+#define CHECK_STRIDE 32         // Bytes between decks in the batch
+#define CHECK_UNIFORM_ROUNDS 2000
+#define CHECK_SPEED_SHUFFLES 2000000
+
+typedef struct { char bytes[248]; } LegacyCard; // A card as ShuffleDeck used to swap it, description inline
+
+static volatile int shuffle_sink;
+
+// Chi-square of how often each card lands in each position. A uniform shuffle gives chi2/df near 1.
+static bool CheckUniformity(uint64_t seed, int size) {
+    static long long counts[CHECK_STRIDE][CHECK_STRIDE];
+    static uint8_t decks[CHECK_BATCH * CHECK_STRIDE];
+    static Rng rngs[CHECK_BATCH];
+    int sizes[CHECK_BATCH];
+    memset(counts, 0, sizeof(counts));
+    for (int k = 0; k < CHECK_BATCH; k++) {
+        Rng_Init(&rngs[k], Rng_SeedFor(seed, (uint64_t)k), RNG_STREAM_SHUFFLE);
+        sizes[k] = size;
+    }
+
+    for (int round = 0; round < CHECK_UNIFORM_ROUNDS; round++) {
+        for (int k = 0; k < CHECK_BATCH; k++) {
+            for (int i = 0; i < size; i++) decks[k * CHECK_STRIDE + i] = (uint8_t)i;
+        }
+        Shuffle_Batch(decks, CHECK_STRIDE, sizes, rngs, CHECK_BATCH);
+        for (int k = 0; k < CHECK_BATCH; k++) {
+            for (int pos = 0; pos < size; pos++) counts[decks[k * CHECK_STRIDE + pos]][pos]++;
+        }
+    }
+
+    double trials = (double)CHECK_BATCH * CHECK_UNIFORM_ROUNDS;
+    double expected = trials / size;
+    double chi2 = 0.0;
+    for (int card = 0; card < size; card++) {
+        for (int pos = 0; pos < size; pos++) {
+            double diff = (double)counts[card][pos] - expected;
+            chi2 += diff * diff / expected;
+        }
+    }
+    double df = (double)(size - 1) * (double)(size - 1);
+    bool pass = fabs(chi2 - df) < 5.0 * sqrt(2.0 * df);
+    printf("uniformity  %2d cards  %.0f shuffles  chi2/df %.3f  %s\n", size, trials, chi2 / df, pass ? "ok" : "FAIL");
+    return pass;
+}
+
+// Shuffles per second of the batch index shuffler against by-value swaps of legacy cards.
+static void CheckSpeed(uint64_t seed, int size) {
+    static LegacyCard legacy[CHECK_STRIDE];
+    static uint8_t decks[CHECK_BATCH * CHECK_STRIDE];
+    static Rng rngs[CHECK_BATCH];
+    int sizes[CHECK_BATCH];
+    for (int k = 0; k < CHECK_BATCH; k++) {
+        Rng_Init(&rngs[k], Rng_SeedFor(seed, (uint64_t)k), RNG_STREAM_SHUFFLE);
+        sizes[k] = size;
+        for (int i = 0; i < size; i++) decks[k * CHECK_STRIDE + i] = (uint8_t)i;
+    }
+    for (int i = 0; i < size; i++) memset(legacy[i].bytes, i, sizeof(legacy[i].bytes));
+
+    Rng rng;
+    Rng_Init(&rng, seed, RNG_STREAM_SHUFFLE);
+    double start = Platform_Seconds();
+    for (int n = 0; n < CHECK_SPEED_SHUFFLES; n++) {
+        for (int i = size - 1; i > 0; i--) {
+            int j = Rng_Range(&rng, 0, i);
+            LegacyCard temp = legacy[i];
+            legacy[i] = legacy[j];
+            legacy[j] = temp;
+        }
+    }
+    double legacy_seconds = Platform_Seconds() - start;
+
+    start = Platform_Seconds();
+    for (int n = 0; n < CHECK_SPEED_SHUFFLES / CHECK_BATCH; n++) {
+        Shuffle_Batch(decks, CHECK_STRIDE, sizes, rngs, CHECK_BATCH);
+    }
+    double batch_seconds = Platform_Seconds() - start;
+
+    double legacy_ns = legacy_seconds * 1e9 / CHECK_SPEED_SHUFFLES;
+    double batch_ns = batch_seconds * 1e9 / ((double)(CHECK_SPEED_SHUFFLES / CHECK_BATCH) * CHECK_BATCH);
+    shuffle_sink = legacy[0].bytes[0] + decks[0]; // Keep both loops observable
+    printf("throughput  %2d cards  legacy %.1f ns  batch %.1f ns  (%.1fx)\n",
+        size, legacy_ns, batch_ns, batch_ns > 0.0 ? legacy_ns / batch_ns : 0.0);
+}
+
+static int RunShuffleCheck(uint64_t seed) {
+    printf("shuffle path: %s  seed: %llu\n", Shuffle_Path(), (unsigned long long)seed);
+    bool pass = true;
+    const int check_sizes[] = { 14, 25 };
+    for (int i = 0; i < 2; i++) pass = CheckUniformity(seed, check_sizes[i]) && pass;
+    for (int i = 0; i < 2; i++) CheckSpeed(seed, check_sizes[i]);
+    return pass ? 0 : 1;
+}
+
+int main(int argc, char** argv) {
+    long long runs = 10000;
+    uint64_t seed = 1;
+    const char* policy_name = "greedy";
+    int threads = Platform_CpuCount();
+    const char* levels_path = "Assets/levels.txt";
+    bool shuffle_check = false;
+    const char* record_dir = NULL;
+    char** replay_paths = NULL;
+    int replay_count = 0;
+    bool replay_trace = false;
+    bool check_hash = false;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--runs") == 0 && i + 1 < argc) runs = atoll(argv[++i]);
+        else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) seed = strtoull(argv[++i], NULL, 10);
+        else if (strcmp(argv[i], "--policy") == 0 && i + 1 < argc) policy_name = argv[++i];
+        else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) threads = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--levels") == 0 && i + 1 < argc) levels_path = argv[++i];
+        else if (strcmp(argv[i], "--shuffle-check") == 0) shuffle_check = true;
+        else if (strcmp(argv[i], "--record") == 0 && i + 1 < argc) record_dir = argv[++i];
+        else if (strcmp(argv[i], "--check-hash") == 0) check_hash = true;
+        else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+            // Every following argument up to the next option is a file, so shell globs work
+            replay_paths = &argv[i + 1];
+            while (i + 1 < argc && strncmp(argv[i + 1], "--", 2) != 0) { i++; replay_count++; }
+        }
+        else if (strcmp(argv[i], "--speed") == 0 && i + 1 < argc) {
+            const char* speed = argv[++i];
+            if (strcmp(speed, "trace") == 0) replay_trace = true;
+            else if (strcmp(speed, "max") != 0) { PrintUsage(); return 1; }
+        }
+        else { PrintUsage(); return 1; }
+    }
+
+    if (shuffle_check) return RunShuffleCheck(seed);
+    if (replay_paths) {
+        int level_count = Levels_Load(levels_path);
+        if (level_count == 0) printf("levels: built-in (%s not loaded)\n", levels_path);
+        return RunReplays(replay_paths, replay_count, replay_trace);
+    }
+
+    RunPolicy policy;
+    if (!RunPolicy_FromName(policy_name, &policy)) {
+        printf("Unknown policy '%s'\n", policy_name);
+        PrintUsage();
+        return 1;
+    }
+
+    if (runs < 0 || runs > (long long)UINT32_MAX) {
+        printf("--runs must be between 0 and %u\n", UINT32_MAX);
+        RunPolicy_Release(&policy);
+        return 1;
+    }
+    // Load before the workers start; they only read the templates
+    int level_count = Levels_Load(levels_path);
+    if (level_count > 0) printf("levels: %d from %s\n", level_count, levels_path);
+    else printf("levels: built-in (%s not loaded)\n", levels_path);
+
+    if (threads < 1) threads = 1;
+    if (threads > WORKPOOL_MAX_WORKERS) threads = WORKPOOL_MAX_WORKERS;
+
+    SimWorker* workers = calloc((size_t)threads, sizeof(SimWorker));
+    if (!workers) { RunPolicy_Release(&policy); return 1; }
+    // Every worker gets its own policy instance (the search policy owns a solver)
+    for (int i = 0; i < threads; i++) {
+        RunPolicy_FromName(policy_name, &workers[i].policy);
+        workers[i].run.check_hashes = check_hash;
+    }
+
+    SimJob job = { workers, seed, record_dir };
+    double start = Platform_Seconds();
+    WorkPool_Run((uint32_t)runs, threads, 256, PlayRuns, &job);
+    double seconds = Platform_Seconds() - start;
+
+    // Integer sums merge identically in any order, so the totals don't depend on the thread count
+    SimStats stats;
+    memset(&stats, 0, sizeof(stats));
+    for (int i = 0; i < threads; i++) MergeStats(&stats, &workers[i].stats);
+
+    PrintStats(&stats, policy.name, seed, threads, seconds);
+    if (check_hash) printf("hash check: %lld mismatches\n", stats.hash_mismatches);
+    for (int i = 0; i < threads; i++) {
+        RunPolicy_Release(&workers[i].policy);
+        Replay_Free(&workers[i].log);
+    }
+    RunPolicy_Release(&policy);
+    free(workers);
+    return stats.hash_mismatches > 0 ? 1 : 0;
+}
@@ -0,0 +1,236 @@
+// @file sprite.c
+// @brief Atlas loading, queued sprite draws and per-frame draw counters.
+//
+// CProcessing has no call that submits several quads at once, so a flush still issues one
+// CP_Image_DrawSubImage per sprite, in call order. With every sprite in one atlas texture the queued
+// draws never switch textures and the renderer can keep them in one pass. Regrouping a queue of
+// loose textures would save switches but draw overlapping sprites in the wrong order, so it doesn't.
+
+#include "sprite.h"
+#include "assets.h"
+#include "platform.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SPRITE_MAX_QUEUED 64
+#define SPRITE_LINE_MAX 128
+
+typedef struct {
+    CP_Image image;        // Atlas or loose texture, NULL if the sprite couldn't be loaded
+    AssetId asset;         // Registry handle behind image, held for the session
+    float s0, t0, s1, t1;  // Rectangle inside image, in pixels
+    bool whole;            // Loose file: draw the whole image
+} Sprite;
+
+typedef struct {
+    SpriteId id;
+    float x, y, w, h;
+    int alpha;
+} QueuedSprite;
+
+static const struct {
+    const char* name;
+    const char* path;
+} sprite_files[SPRITE_COUNT] = {
+    { "player",      "Assets/player.png" },
+    { "goblin",      "Assets/goblin.png" },
+    { "slime",       "Assets/slime.png" },
+    { "witch",       "Assets/witch.png" },
+    { "orc",         "Assets/orc.png" },
+    { "ogre",        "Assets/ogre.png" },
+    { "shadow",      "Assets/shadow.png" },
+    { "lich",        "Assets/lich.png" },
+    { "icon_sword",  "Assets/icon_sword.png" },
+    { "icon_heart",  "Assets/icon_heart.png" },
+    { "icon_shield", "Assets/icon_shield.png" },
+};
+
+static Sprite sprites[SPRITE_COUNT];
+static bool loaded = false;
+
+static QueuedSprite queue[SPRITE_MAX_QUEUED];
+static int queue_count = 0;
+static bool batching = false;
+
+static SpriteStats frame_stats;
+static SpriteStats last_frame_stats;
+static CP_Image last_texture = NULL;
+
+// Parses the rectangles in the atlas manifest into sprites. Returns how many were found.
+static int ReadManifest(AssetId atlas) {
+    FILE* file = fopen(SPRITE_ATLAS_MANIFEST, "r");
+    if (!file) return 0;
+
+    int found = 0;
+    char line[SPRITE_LINE_MAX];
+    while (fgets(line, sizeof(line), file)) {
+        char* p = line;
+        while (*p == ' ' || *p == '\t') p++;
+        if (*p == '#' || *p == '\n' || *p == '\r' || *p == '\0') continue;
+
+        char* name_end = p;
+        while (*name_end && *name_end != ' ' && *name_end != '\t') name_end++;
+        size_t name_len = (size_t)(name_end - p);
+
+        long rect[4];
+        char* cursor = name_end;
+        bool ok = true;
+        for (int i = 0; i < 4 && ok; i++) {
+            char* next;
+            rect[i] = strtol(cursor, &next, 10);
+            ok = next != cursor && rect[i] >= 0;
+            cursor = next;
+        }
+        if (!ok || rect[2] == 0 || rect[3] == 0) {
+            printf("Warning: bad line in %s: %s", SPRITE_ATLAS_MANIFEST, line);
+            continue;
+        }
+
+        for (int id = 0; id < SPRITE_COUNT; id++) {
+            if (strlen(sprite_files[id].name) != name_len || strncmp(sprite_files[id].name, p, name_len) != 0) continue;
+            Sprite* sprite = &sprites[id];
+            sprite->asset = atlas;
+            sprite->image = Asset_Image(atlas);
+            sprite->s0 = (float)rect[0];
+            sprite->t0 = (float)rect[1];
+            sprite->s1 = (float)(rect[0] + rect[2]);
+            sprite->t1 = (float)(rect[1] + rect[3]);
+            sprite->whole = false;
+            found++;
+            break;
+        }
+    }
+    fclose(file);
+    return found;
+}
+
+void Sprite_Preload(void) {
+    if (Platform_FileStamp(SPRITE_ATLAS_MANIFEST, NULL, NULL)) {
+        Asset_Preload(ASSET_IMAGE, SPRITE_ATLAS_IMAGE);
+        return;
+    }
+    for (int id = 0; id < SPRITE_COUNT; id++) Asset_Preload(ASSET_IMAGE, sprite_files[id].path);
+}
+
+void Sprite_Load(void) {
+    if (loaded) return;
+    loaded = true;
+
+    // Every sprite in the atlas holds its own reference to it
+    bool has_manifest = Platform_FileStamp(SPRITE_ATLAS_MANIFEST, NULL, NULL);
+    AssetId atlas = has_manifest ? Asset_Acquire(ASSET_IMAGE, SPRITE_ATLAS_IMAGE) : ASSET_NONE;
+    if (Asset_Image(atlas)) {
+        ReadManifest(atlas);
+        for (int id = 0; id < SPRITE_COUNT; id++) {
+            if (sprites[id].asset == atlas) Asset_Acquire(ASSET_IMAGE, SPRITE_ATLAS_IMAGE);
+        }
+    }
+    Asset_Release(&atlas);
+
+    // Anything the atlas doesn't cover comes from its own file
+    for (int id = 0; id < SPRITE_COUNT; id++) {
+        Sprite* sprite = &sprites[id];
+        if (sprite->image) continue;
+        sprite->asset = Asset_Acquire(ASSET_IMAGE, sprite_files[id].path);
+        sprite->image = Asset_Image(sprite->asset);
+        sprite->whole = true;
+        if (!sprite->image) continue;
+        sprite->s0 = 0.0f;
+        sprite->t0 = 0.0f;
+        sprite->s1 = (float)CP_Image_GetWidth(sprite->image);
+        sprite->t1 = (float)CP_Image_GetHeight(sprite->image);
+    }
+}
+
+SpriteId Sprite_ForName(const char* name) {
+    if (!name) return SPRITE_NONE;
+    if (strcmp(name, "Player") == 0) return SPRITE_PLAYER;
+    if (strstr(name, "Goblin") != NULL) return SPRITE_GOBLIN;
+    if (strstr(name, "Slime") != NULL)  return SPRITE_SLIME;
+    if (strstr(name, "Witch") != NULL)  return SPRITE_WITCH;
+    if (strstr(name, "Orc") != NULL)    return SPRITE_ORC;
+    if (strstr(name, "Ogre") != NULL)   return SPRITE_OGRE;
+    if (strstr(name, "OGRE") != NULL)   return SPRITE_OGRE;
+    if (strstr(name, "Shadow") != NULL) return SPRITE_SHADOW;
+    if (strstr(name, "LICH") != NULL)   return SPRITE_LICH;
+    if (strstr(name, "Lich") != NULL)   return SPRITE_LICH;
+    return SPRITE_NONE;
+}
+
+float Sprite_Width(SpriteId id) {
+    Sprite_Load();
+    return (id < SPRITE_COUNT && sprites[id].image) ? sprites[id].s1 - sprites[id].s0 : 0.0f;
+}
+
+float Sprite_Height(SpriteId id) {
+    Sprite_Load();
+    return (id < SPRITE_COUNT && sprites[id].image) ? sprites[id].t1 - sprites[id].t0 : 0.0f;
+}
+
+static void CountImageDraw(CP_Image image) {
+    frame_stats.image_draws++;
+    if (image != last_texture) {
+        frame_stats.texture_switches++;
+        last_texture = image;
+    }
+}
+
+static void DrawNow(const QueuedSprite* q) {
+    const Sprite* sprite = &sprites[q->id];
+    CountImageDraw(sprite->image);
+    if (sprite->whole) {
+        CP_Image_Draw(sprite->image, q->x, q->y, q->w, q->h, q->alpha);
+    }
+    else {
+        CP_Image_DrawSubImage(sprite->image, q->x, q->y, q->w, q->h,
+            sprite->s0, sprite->t0, sprite->s1, sprite->t1, q->alpha);
+    }
+}
+
+void Sprite_Draw(SpriteId id, float x, float y, float w, float h, int alpha) {
+    Sprite_Load();
+    if (id >= SPRITE_COUNT || !sprites[id].image) return;
+    frame_stats.sprites++;
+
+    QueuedSprite q = { id, x, y, w, h, alpha };
+    if (!batching) {
+        DrawNow(&q);
+        return;
+    }
+    if (queue_count == SPRITE_MAX_QUEUED) {
+        Sprite_Flush();
+        batching = true;
+    }
+    queue[queue_count++] = q;
+}
+
+void Sprite_DrawImage(CP_Image image, float x, float y, float w, float h, int alpha) {
+    if (!image) return;
+    CountImageDraw(image);
+    CP_Image_Draw(image, x, y, w, h, alpha);
+}
+
+void Sprite_BeginBatch(void) {
+    if (batching) Sprite_Flush();
+    batching = true;
+}
+
+void Sprite_Flush(void) {
+    batching = false;
+    if (queue_count == 0) return;
+    frame_stats.batches++;
+
+    for (int i = 0; i < queue_count; i++) DrawNow(&queue[i]);
+    queue_count = 0;
+}
+
+void Sprite_BeginFrame(void) {
+    last_frame_stats = frame_stats;
+    memset(&frame_stats, 0, sizeof(frame_stats));
+    last_texture = NULL;
+}
+
+SpriteStats Sprite_FrameStats(void) {
+    return last_frame_stats;
+}
@@ -0,0 +1,71 @@
+// Sprite atlas and draw batching for the combat scene. Every sprite is a rectangle in one texture
+// packed offline by tools/pack_atlas.py (Assets/atlas.png, rectangles listed in Assets/atlas.txt); when
+// the atlas is missing each sprite falls back to its own PNG. Draws queued between Sprite_BeginBatch and
+// Sprite_Flush are submitted in call order, and the draw counters below show what a frame cost.
+//
+// A batch is still one CP_Image_DrawSubImage per sprite: CProcessing has no call that submits several
+// quads at once. What the atlas saves is texture switches, not draw calls, so with it image_draws stays
+// the same and texture_switches drops to about one per batch.
+#pragma once
+#include "cprocessing.h"
+#include <stdbool.h>
+
+#define SPRITE_ATLAS_IMAGE "Assets/atlas.png"
+#define SPRITE_ATLAS_MANIFEST "Assets/atlas.txt" // One "name x y w h" line per sprite, '#' starts a comment
+
+// Every sprite the game draws. The atlas manifest names them like the loose files (player, goblin, ...).
+typedef enum {
+    SPRITE_PLAYER,
+    SPRITE_GOBLIN,
+    SPRITE_SLIME,
+    SPRITE_WITCH,
+    SPRITE_ORC,
+    SPRITE_OGRE,
+    SPRITE_SHADOW,
+    SPRITE_LICH,
+    SPRITE_ICON_SWORD,
+    SPRITE_ICON_HEART,
+    SPRITE_ICON_SHIELD,
+    SPRITE_COUNT,
+    SPRITE_NONE = SPRITE_COUNT
+} SpriteId;
+
+// Draw counters for one frame.
+typedef struct {
+    int sprites;          // Sprites drawn through Sprite_Draw
+    int image_draws;      // CP_Image draw calls issued, sprites and whole images together
+    int texture_switches; // Image draws whose texture differs from the previous image draw
+    int batches;          // Non-empty Sprite_Flush calls
+} SpriteStats;
+
+// Queues the atlas, or the loose PNGs if there's no atlas manifest, for the asset preloader (see assets.h).
+void Sprite_Preload(void);
+
+// Loads the atlas, or the loose PNGs for sprites it doesn't cover. Called on first use; safe to repeat.
+void Sprite_Load(void);
+
+// Returns the sprite for an entity name ("Player", "Goblin Scout", "LICH KING", ...), SPRITE_NONE if none.
+SpriteId Sprite_ForName(const char* name);
+
+// Returns the sprite's size in pixels, 0 if it isn't loaded.
+float Sprite_Width(SpriteId id);
+float Sprite_Height(SpriteId id);
+
+// Draws a sprite centered on (x, y) like CP_Image_Draw. Inside a batch it's queued until Sprite_Flush.
+void Sprite_Draw(SpriteId id, float x, float y, float w, float h, int alpha);
+
+// Draws a whole image right away and counts it. For images that aren't in the atlas (the background).
+void Sprite_DrawImage(CP_Image image, float x, float y, float w, float h, int alpha);
+
+// Starts queueing Sprite_Draw calls. Only sprites may overlap each other until the flush.
+void Sprite_BeginBatch(void);
+
+// Draws the queued sprites in call order, so overlapping sprites stack the same with or without the
+// atlas, and ends the batch.
+void Sprite_Flush(void);
+
+// Starts counting a new frame. The finished frame's counters stay readable through Sprite_FrameStats.
+void Sprite_BeginFrame(void);
+
+// Returns the counters of the last finished frame.
+SpriteStats Sprite_FrameStats(void);
@@ -0,0 +1,78 @@
+// @file text.c
+// @brief Cached line formatting and deduplicated text state for Text_Draw.
+//
+// CProcessing lays text out inside CP_Font_DrawText and gives no access to glyph runs, so those
+// can't be kept between frames. What can be saved is the work around each draw: the snprintf for
+// lines whose numbers didn't change and the setting calls that would repeat the current state.
+
+#include "text.h"
+#include <stdio.h>
+#include <string.h>
+
+static TextStyle current;
+static bool current_valid = false;
+
+static TextStats frame_stats;
+static TextStats last_frame_stats;
+
+static bool SameColor(CP_Color a, CP_Color b) {
+    return a.r == b.r && a.g == b.g && a.b == b.b && a.a == b.a;
+}
+
+void Text_Begin(void) {
+    current_valid = false;
+}
+
+void Text_Draw(const TextStyle* style, const char* text, float x, float y) {
+    if (!style || !text) return;
+
+    if (!current_valid || current.font != style->font) {
+        CP_Font_Set(style->font);
+        frame_stats.state_changes++;
+    }
+    else frame_stats.state_skipped++;
+
+    if (!current_valid || current.size != style->size) {
+        CP_Settings_TextSize(style->size);
+        frame_stats.state_changes++;
+    }
+    else frame_stats.state_skipped++;
+
+    if (!current_valid || current.align_h != style->align_h || current.align_v != style->align_v) {
+        CP_Settings_TextAlignment(style->align_h, style->align_v);
+        frame_stats.state_changes++;
+    }
+    else frame_stats.state_skipped++;
+
+    if (!current_valid || !SameColor(current.fill, style->fill)) {
+        CP_Settings_Fill(style->fill);
+        frame_stats.state_changes++;
+    }
+    else frame_stats.state_skipped++;
+
+    current = *style;
+    current_valid = true;
+
+    CP_Font_DrawText(text, x, y);
+    frame_stats.draws++;
+}
+
+const char* Text_Format(TextLine* line, const char* format, int a, int b) {
+    if (line->format != format || line->a != a || line->b != b) {
+        snprintf(line->text, sizeof(line->text), format, a, b);
+        line->format = format;
+        line->a = a;
+        line->b = b;
+        frame_stats.formats++;
+    }
+    return line->text;
+}
+
+void Text_BeginFrame(void) {
+    last_frame_stats = frame_stats;
+    memset(&frame_stats, 0, sizeof(frame_stats));
+}
+
+TextStats Text_FrameStats(void) {
+    return last_frame_stats;
+}
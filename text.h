@@ -0,0 +1,46 @@
+// Text drawing for the HUD and floating numbers. Lines built from a few integers are formatted only
+// when those change, and font, size, alignment and fill are only sent to CProcessing when they differ
+// from what the previous styled draw left set.
+#pragma once
+#include "cprocessing.h"
+#include <stdbool.h>
+
+// Everything CProcessing needs set before a line of text is drawn.
+typedef struct {
+    CP_Font font;
+    float size;
+    CP_TEXT_ALIGN_HORIZONTAL align_h;
+    CP_TEXT_ALIGN_VERTICAL align_v;
+    CP_Color fill;
+} TextStyle;
+
+// A line formatted from up to two integers ("Level %d | Turn %d"). Zero-initialize before first use.
+typedef struct {
+    const char* format;
+    int a, b;
+    char text[64];
+} TextLine;
+
+// Counters for one frame.
+typedef struct {
+    int draws;          // Lines drawn through Text_Draw
+    int state_changes;  // Font/size/alignment/fill calls made
+    int state_skipped;  // Calls left out because the setting was already in place
+    int formats;        // Lines re-formatted by Text_Format
+} TextStats;
+
+// Forgets the text settings in effect. Call before a run of Text_Draw calls, since code outside this
+// module may have changed them since.
+void Text_Begin(void);
+
+// Draws text at (x, y), applying only the parts of style that changed since the last Text_Draw.
+void Text_Draw(const TextStyle* style, const char* text, float x, float y);
+
+// Returns line's text for format with values a and b, formatting it only if any of them changed.
+const char* Text_Format(TextLine* line, const char* format, int a, int b);
+
+// Starts counting a new frame. The finished frame's counters stay readable through Text_FrameStats.
+void Text_BeginFrame(void);
+
+// Returns the counters of the last finished frame.
+TextStats Text_FrameStats(void);
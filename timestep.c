@@ -0,0 +1,35 @@
+// @file timestep.c
+// @brief Fixed-step accumulator behind the game's logic ticks.
+
+#include "timestep.h"
+
+void Timestep_Init(Timestep* clock, bool instant) {
+    clock->accumulator = 0.0f;
+    clock->alpha = instant ? 1.0f : 0.0f;
+    clock->instant = instant;
+}
+
+int Timestep_Advance(Timestep* clock, float frame_dt) {
+    // Every animation finishes within a few ticks, so there's nothing left to interpolate
+    if (clock->instant) return TIMESTEP_INSTANT_TICKS;
+
+    if (frame_dt < 0.0f) frame_dt = 0.0f;
+    clock->accumulator += frame_dt;
+    int ticks = (int)(clock->accumulator / TIMESTEP_DT);
+    if (ticks > TIMESTEP_MAX_TICKS) {
+        ticks = TIMESTEP_MAX_TICKS;
+        clock->accumulator = (float)ticks * TIMESTEP_DT;
+    }
+    clock->accumulator -= (float)ticks * TIMESTEP_DT;
+    if (clock->accumulator < 0.0f) clock->accumulator = 0.0f; // Float rounding
+    clock->alpha = clock->accumulator / TIMESTEP_DT;
+    return ticks;
+}
+
+float Timestep_TickDt(const Timestep* clock) {
+    return clock->instant ? TIMESTEP_INSTANT_DT : TIMESTEP_DT;
+}
+
+float Timestep_Alpha(const Timestep* clock) {
+    return clock->alpha;
+}
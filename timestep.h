@@ -0,0 +1,30 @@
+// Fixed-rate logic clock. Turns variable frame times into a whole number of fixed ticks plus the
+// fraction of a tick left over, which rendering uses to interpolate between the last two ticks.
+// Instant mode collapses every timer and animation so turns resolve as fast as the logic runs.
+// Never touches CProcessing.
+#pragma once
+#include <stdbool.h>
+
+#define TIMESTEP_RATE 120                     // Logic ticks per second
+#define TIMESTEP_DT (1.0f / TIMESTEP_RATE)
+#define TIMESTEP_MAX_TICKS 12                 // Per frame; after a stall the clock drops time instead of catching up
+#define TIMESTEP_INSTANT_DT 1.0e6f            // Tick length in instant mode: longer than any timer
+#define TIMESTEP_INSTANT_TICKS 64             // Ticks per frame in instant mode
+
+typedef struct {
+    float accumulator; // Frame time not yet consumed by ticks
+    float alpha;       // accumulator / TIMESTEP_DT after the last Timestep_Advance, in [0, 1)
+    bool instant;
+} Timestep;
+
+// Resets the clock.
+void Timestep_Init(Timestep* clock, bool instant);
+
+// Adds one frame's time and returns how many logic ticks to run for it.
+int Timestep_Advance(Timestep* clock, float frame_dt);
+
+// Returns the length of one logic tick in seconds.
+float Timestep_TickDt(const Timestep* clock);
+
+// Returns how far rendering sits between the previous tick (0) and the last one (1).
+float Timestep_Alpha(const Timestep* clock);
@@ -0,0 +1,223 @@
+#!/usr/bin/env python3
+# @file pack_atlas.py
+# @brief Packs the loose sprite PNGs into Assets/atlas.png and writes Assets/atlas.txt for sprite.c.
+#
+# Usage (from the repo root): python3 tools/pack_atlas.py [--assets DIR] [--padding N]
+#
+# Standard library only. Reads 8- and 16-bit non-interlaced PNGs of any colour type and writes one RGBA
+# atlas with a "name x y w h" manifest line per sprite. A sprite whose PNG is missing is left out and
+# the game loads it from its own file, as it does when there's no atlas at all.
+
+import argparse
+import math
+import os
+import struct
+import sys
+import zlib
+
+# Same names and order as sprite_files in sprite.c
+SPRITE_NAMES = [
+    "player", "goblin", "slime", "witch", "orc", "ogre", "shadow", "lich",
+    "icon_sword", "icon_heart", "icon_shield",
+]
+
+PNG_SIGNATURE = b"\x89PNG\r\n\x1a\n"
+CHANNELS = {0: 1, 2: 3, 3: 1, 4: 2, 6: 4}  # Colour type -> samples per pixel
+
+
+class Image:
+    def __init__(self, width, height, rgba):
+        self.width = width
+        self.height = height
+        self.rgba = rgba  # bytearray, 4 bytes per pixel, rows top to bottom
+
+
+def paeth(a, b, c):
+    p = a + b - c
+    pa, pb, pc = abs(p - a), abs(p - b), abs(p - c)
+    if pa <= pb and pa <= pc:
+        return a
+    return b if pb <= pc else c
+
+
+def unfilter(data, width, height, bits_per_pixel):
+    stride = (width * bits_per_pixel + 7) // 8
+    step = max(1, bits_per_pixel // 8)
+    rows = []
+    prev = bytearray(stride)
+    pos = 0
+    for _ in range(height):
+        kind = data[pos]
+        row = bytearray(data[pos + 1:pos + 1 + stride])
+        pos += 1 + stride
+        for i in range(stride):
+            left = row[i - step] if i >= step else 0
+            up = prev[i]
+            up_left = prev[i - step] if i >= step else 0
+            if kind == 1:
+                row[i] = (row[i] + left) & 0xFF
+            elif kind == 2:
+                row[i] = (row[i] + up) & 0xFF
+            elif kind == 3:
+                row[i] = (row[i] + ((left + up) >> 1)) & 0xFF
+            elif kind == 4:
+                row[i] = (row[i] + paeth(left, up, up_left)) & 0xFF
+            elif kind != 0:
+                raise ValueError("bad filter type %d" % kind)
+        rows.append(row)
+        prev = row
+    return rows
+
+
+def read_png(path):
+    with open(path, "rb") as f:
+        data = f.read()
+    if data[:8] != PNG_SIGNATURE:
+        raise ValueError("not a PNG")
+
+    pos = 8
+    header = None
+    palette = b""
+    transparency = b""
+    idat = bytearray()
+    while pos < len(data):
+        length, kind = struct.unpack(">I4s", data[pos:pos + 8])
+        body = data[pos + 8:pos + 8 + length]
+        pos += 12 + length
+        if kind == b"IHDR":
+            header = struct.unpack(">IIBBBBB", body)
+        elif kind == b"PLTE":
+            palette = body
+        elif kind == b"tRNS":
+            transparency = body
+        elif kind == b"IDAT":
+            idat += body
+        elif kind == b"IEND":
+            break
+    if header is None:
+        raise ValueError("no IHDR chunk")
+
+    width, height, depth, colour, _, _, interlace = header
+    if colour not in CHANNELS:
+        raise ValueError("unknown colour type %d" % colour)
+    if interlace:
+        raise ValueError("interlaced PNGs are not supported")
+    channels = CHANNELS[colour]
+    rows = unfilter(zlib.decompress(bytes(idat)), width, height, depth * channels)
+
+    # Colour key for grey and RGB images (tRNS holds 16-bit samples)
+    key = None
+    if transparency and colour in (0, 2):
+        key = struct.unpack(">%dH" % (len(transparency) // 2), transparency)
+
+    rgba = bytearray(width * height * 4)
+    out = 0
+    for row in rows:
+        if depth == 16:
+            raw = struct.unpack(">%dH" % (width * channels), bytes(row))
+            samples = [s >> 8 for s in raw]
+        elif depth == 8:
+            raw = samples = row
+        else:
+            # 1, 2 or 4 bits per sample, packed from the high bits down
+            per_byte = 8 // depth
+            mask = (1 << depth) - 1
+            raw = [(row[i // per_byte] >> (8 - depth * (i % per_byte + 1))) & mask for i in range(width * channels)]
+            scale = 255 // mask if colour != 3 else 1
+            samples = [s * scale for s in raw]
+
+        for x in range(width):
+            s = samples[x * channels:(x + 1) * channels]
+            if colour == 3:
+                index = s[0]
+                r, g, b = palette[index * 3:index * 3 + 3]
+                a = transparency[index] if index < len(transparency) else 255
+            elif colour in (0, 4):
+                r = g = b = s[0]
+                a = s[1] if colour == 4 else 255
+            else:
+                r, g, b = s[0], s[1], s[2]
+                a = s[3] if colour == 6 else 255
+            if key is not None and tuple(raw[x * channels:(x + 1) * channels]) == key:
+                a = 0
+            rgba[out:out + 4] = bytes((r, g, b, a))
+            out += 4
+    return Image(width, height, rgba)
+
+
+def write_png(path, image):
+    def chunk(kind, body):
+        return struct.pack(">I", len(body)) + kind + body + struct.pack(">I", zlib.crc32(kind + body) & 0xFFFFFFFF)
+
+    stride = image.width * 4
+    raw = bytearray()
+    for y in range(image.height):
+        raw.append(0)  # No filter
+        raw += image.rgba[y * stride:(y + 1) * stride]
+    header = struct.pack(">IIBBBBB", image.width, image.height, 8, 6, 0, 0, 0)
+    with open(path, "wb") as f:
+        f.write(PNG_SIGNATURE + chunk(b"IHDR", header) + chunk(b"IDAT", zlib.compress(bytes(raw), 9)) + chunk(b"IEND", b""))
+
+
+def pack(images, padding):
+    """Shelf packing, tallest first. Returns (width, height, {name: (x, y)})."""
+    area = sum((img.width + padding) * (img.height + padding) for img in images.values())
+    widest = max(img.width for img in images.values()) + padding
+    width = 1 << max(widest - 1, int(math.sqrt(area))).bit_length()
+
+    places = {}
+    x = y = shelf = 0
+    for name in sorted(images, key=lambda n: (-images[n].height, n)):
+        img = images[name]
+        if x + img.width + padding > width:
+            x, y, shelf = 0, y + shelf, 0
+        places[name] = (x, y)
+        x += img.width + padding
+        shelf = max(shelf, img.height + padding)
+    return width, y + shelf, places
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Pack the loose sprite PNGs into the sprite atlas.")
+    parser.add_argument("--assets", default="Assets", help="folder with the loose PNGs; the atlas is written here")
+    parser.add_argument("--padding", type=int, default=2, help="transparent pixels between sprites (keeps filtering from bleeding)")
+    args = parser.parse_args()
+
+    images = {}
+    for name in SPRITE_NAMES:
+        path = os.path.join(args.assets, name + ".png")
+        if not os.path.exists(path):
+            print("%s: missing, the game will load it on its own" % path)
+            continue
+        try:
+            images[name] = read_png(path)
+        except (ValueError, zlib.error, struct.error) as error:
+            print("%s: %s, left out" % (path, error))
+    if not images:
+        print("no sprites to pack")
+        return 1
+
+    width, height, places = pack(images, args.padding)
+    atlas = Image(width, height, bytearray(width * height * 4))
+    for name, (x, y) in places.items():
+        img = images[name]
+        for row in range(img.height):
+            dst = ((y + row) * width + x) * 4
+            atlas.rgba[dst:dst + img.width * 4] = img.rgba[row * img.width * 4:(row + 1) * img.width * 4]
+
+    image_path = os.path.join(args.assets, "atlas.png")
+    manifest_path = os.path.join(args.assets, "atlas.txt")
+    write_png(image_path, atlas)
+    with open(manifest_path, "w", newline="\n") as f:
+        f.write("# Written by tools/pack_atlas.py; rebuild it after changing a sprite PNG\n")
+        f.write("# name x y w h\n")
+        for name in SPRITE_NAMES:
+            if name in places:
+                x, y = places[name]
+                f.write("%s %d %d %d %d\n" % (name, x, y, images[name].width, images[name].height))
+    print("%s: %d sprites in %dx%d, rectangles in %s" % (image_path, len(places), width, height, manifest_path))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,197 @@
+// @file trace.c
+// @brief Per-thread event buffers and the Chrome trace JSON writer.
+//
+// A thread's first event allocates its buffer and pushes it onto a global list with a compare-
+// exchange; after that only the owning thread writes to it. Events go into 1024-event chunks that
+// the owner links up as they fill, so recording never waits on another thread (the chunk allocation
+// itself is a plain malloc every 1024 events).
+
+#include "trace.h"
+#include "platform.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TRACE_CHUNK_EVENTS 1024
+#define TRACE_MAX_CHUNKS 1024 // Per thread, 64 MB; later events are dropped and counted
+#define TRACE_THREAD_NAME_SIZE 32
+
+// One event, 64 bytes.
+typedef struct {
+    double seconds;       // Platform_Seconds() when recorded
+    const char* category;
+    uint32_t id;          // Async events only
+    char phase;           // Chrome trace "ph": B, E, b, e or i
+    char name[TRACE_NAME_SIZE];
+} TraceEvent;
+
+typedef struct TraceChunk {
+    struct TraceChunk* next;
+    int count;
+    TraceEvent events[TRACE_CHUNK_EVENTS];
+} TraceChunk;
+
+typedef struct TraceBuffer {
+    struct TraceBuffer* next; // Global list, newest first
+    uint32_t thread_id;
+    char thread_name[TRACE_THREAD_NAME_SIZE];
+    TraceChunk* first;
+    TraceChunk* last;
+    int chunk_count;
+    uint64_t dropped;
+} TraceBuffer;
+
+static bool enabled = false;
+static char trace_path[260];
+static double origin = 0.0;
+static PlatformAtomic64 buffer_list;    // TraceBuffer*, pushed with compare-exchange
+static PlatformAtomic64 next_thread_id;
+static PLATFORM_THREAD_LOCAL TraceBuffer* local_buffer = NULL;
+
+void Trace_Start(const char* path) {
+    if (!path || enabled) return;
+    snprintf(trace_path, sizeof(trace_path), "%s", path);
+    origin = Platform_Seconds();
+    Platform_AtomicStore64(&buffer_list, 0);
+    Platform_AtomicStore64(&next_thread_id, 1);
+    enabled = true;
+    Trace_SetThreadName("Main");
+}
+
+bool Trace_Enabled(void) {
+    return enabled;
+}
+
+// Returns the calling thread's buffer, creating and registering it on first use.
+static TraceBuffer* LocalBuffer(void) {
+    if (local_buffer) return local_buffer;
+    TraceBuffer* buffer = calloc(1, sizeof(TraceBuffer));
+    if (!buffer) return NULL;
+
+    uint64_t id;
+    do id = Platform_AtomicLoad64(&next_thread_id);
+    while (!Platform_AtomicCompareExchange64(&next_thread_id, id, id + 1));
+    buffer->thread_id = (uint32_t)id;
+    snprintf(buffer->thread_name, sizeof(buffer->thread_name), "Thread %u", buffer->thread_id);
+
+    uint64_t head;
+    do {
+        head = Platform_AtomicLoad64(&buffer_list);
+        buffer->next = (TraceBuffer*)(uintptr_t)head;
+    } while (!Platform_AtomicCompareExchange64(&buffer_list, head, (uint64_t)(uintptr_t)buffer));
+
+    local_buffer = buffer;
+    return buffer;
+}
+
+static void Record(char phase, const char* category, const char* name, uint32_t id) {
+    double now = Platform_Seconds();
+    TraceBuffer* buffer = LocalBuffer();
+    if (!buffer) return;
+
+    TraceChunk* chunk = buffer->last;
+    if (!chunk || chunk->count == TRACE_CHUNK_EVENTS) {
+        chunk = buffer->chunk_count < TRACE_MAX_CHUNKS ? malloc(sizeof(TraceChunk)) : NULL;
+        if (!chunk) { buffer->dropped++; return; }
+        chunk->next = NULL;
+        chunk->count = 0;
+        if (buffer->last) buffer->last->next = chunk;
+        else buffer->first = chunk;
+        buffer->last = chunk;
+        buffer->chunk_count++;
+    }
+
+    TraceEvent* event = &chunk->events[chunk->count++];
+    event->seconds = now;
+    event->category = category ? category : "";
+    event->id = id;
+    event->phase = phase;
+    snprintf(event->name, sizeof(event->name), "%s", name ? name : "");
+}
+
+void Trace_SetThreadName(const char* name) {
+    if (!enabled || !name) return;
+    TraceBuffer* buffer = LocalBuffer();
+    if (buffer) snprintf(buffer->thread_name, sizeof(buffer->thread_name), "%s", name);
+}
+
+void Trace_Begin(const char* category, const char* name) {
+    if (enabled) Record('B', category, name, 0);
+}
+
+void Trace_End(const char* category, const char* name) {
+    if (enabled) Record('E', category, name, 0);
+}
+
+void Trace_AsyncBegin(const char* category, const char* name, uint32_t id) {
+    if (enabled) Record('b', category, name, id);
+}
+
+void Trace_AsyncEnd(const char* category, const char* name, uint32_t id) {
+    if (enabled) Record('e', category, name, id);
+}
+
+void Trace_Instant(const char* category, const char* name) {
+    if (enabled) Record('i', category, name, 0);
+}
+
+// --- Output ---
+
+// Writes text as the body of a JSON string.
+static void WriteEscaped(FILE* file, const char* text) {
+    for (; *text; text++) {
+        unsigned char c = (unsigned char)*text;
+        if (c == '"' || c == '\\') fprintf(file, "\\%c", c);
+        else if (c < 0x20) fprintf(file, "\\u%04x", c);
+        else fputc(c, file);
+    }
+}
+
+static void WriteEvent(FILE* file, const TraceBuffer* buffer, const TraceEvent* event) {
+    fprintf(file, ",\n{\"ph\":\"%c\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"cat\":\"",
+        event->phase, buffer->thread_id, (event->seconds - origin) * 1e6);
+    WriteEscaped(file, event->category);
+    fprintf(file, "\",\"name\":\"");
+    WriteEscaped(file, event->name);
+    fputc('"', file);
+    if (event->phase == 'b' || event->phase == 'e') fprintf(file, ",\"id\":%u", event->id);
+    if (event->phase == 'i') fprintf(file, ",\"s\":\"t\"");
+    fputc('}', file);
+}
+
+void Trace_Shutdown(void) {
+    if (!enabled) return;
+    enabled = false;
+
+    FILE* file = fopen(trace_path, "w");
+    if (!file) printf("WARNING: Failed to write trace %s\n", trace_path);
+    if (file) fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n"
+        "{\"ph\":\"M\",\"pid\":1,\"name\":\"process_name\",\"args\":{\"name\":\"HexHand\"}}");
+
+    TraceBuffer* buffer = (TraceBuffer*)(uintptr_t)Platform_AtomicLoad64(&buffer_list);
+    while (buffer) {
+        if (file) {
+            fprintf(file, ",\n{\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"name\":\"thread_name\",\"args\":{\"name\":\"", buffer->thread_id);
+            WriteEscaped(file, buffer->thread_name);
+            fprintf(file, "\"}}");
+            if (buffer->dropped > 0) printf("WARNING: Trace dropped %llu events from %s\n", (unsigned long long)buffer->dropped, buffer->thread_name);
+        }
+        TraceChunk* chunk = buffer->first;
+        while (chunk) {
+            for (int i = 0; file && i < chunk->count; i++) WriteEvent(file, buffer, &chunk->events[i]);
+            TraceChunk* next_chunk = chunk->next;
+            free(chunk);
+            chunk = next_chunk;
+        }
+        TraceBuffer* next = buffer->next;
+        free(buffer);
+        buffer = next;
+    }
+    Platform_AtomicStore64(&buffer_list, 0);
+    local_buffer = NULL; // Only the calling thread's pointer; the others have exited
+
+    if (file) {
+        fprintf(file, "\n]}\n");
+        if (fclose(file) != 0) printf("WARNING: Failed to write trace %s\n", trace_path);
+    }
+}
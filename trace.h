@@ -0,0 +1,49 @@
+// Timeline recorder: begin/end events written as Chrome trace JSON (open in chrome://tracing or
+// ui.perfetto.dev). Each thread records into its own buffer without locks; Trace_Shutdown writes
+// everything out on exit. Recording is off unless Trace_Start was called, and then every call is a
+// single flag check. Never touches CProcessing.
+#pragma once
+#include <stdbool.h>
+#include <stdint.h>
+
+// Categories. Pass these (or other string literals): the category pointer is kept, not copied.
+#define TRACE_CAT_STATE "state"  // Screen lifetimes, Init to Exit
+#define TRACE_CAT_ASSET "asset"  // File loads and preloading
+#define TRACE_CAT_ENEMY "enemy"  // Enemy turn phases
+#define TRACE_CAT_FRAME "frame"  // Game_Update and its sections
+
+// Ids for the async spans. Screens never overlap, so they share one.
+#define TRACE_ID_SCREEN 1
+#define TRACE_ID_ENEMY_TURN 2
+
+#define TRACE_NAME_SIZE 43 // Longer names are cut short (they're copied into the event)
+
+// Starts recording. Events are written to path by Trace_Shutdown. Call before any other thread starts.
+void Trace_Start(const char* path);
+
+// Returns true while recording.
+bool Trace_Enabled(void);
+
+// Names the calling thread in the timeline.
+void Trace_SetThreadName(const char* name);
+
+// Opens a span on the calling thread. Spans on one thread must close in reverse order, within the
+// function that opened them.
+void Trace_Begin(const char* category, const char* name);
+
+// Closes the innermost open span on the calling thread.
+void Trace_End(const char* category, const char* name);
+
+// Opens a span that may outlast the current frame (a screen, the enemy turn). Spans with the same
+// category and id nest; close them with Trace_AsyncEnd and the same arguments.
+void Trace_AsyncBegin(const char* category, const char* name, uint32_t id);
+
+// Closes a span opened with Trace_AsyncBegin.
+void Trace_AsyncEnd(const char* category, const char* name, uint32_t id);
+
+// Marks a single point in time on the calling thread.
+void Trace_Instant(const char* category, const char* name);
+
+// Writes every thread's events to the file given to Trace_Start, frees the buffers and stops
+// recording. Call once the threads that recorded have been joined.
+void Trace_Shutdown(void);
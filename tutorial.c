@@ -2,10 +2,13 @@
 #include "cprocessing.h"    
 #include "mainmenu.h"       
 #include "utils.h"          
+#include "assets.h"
+#include "trace.h"
 #include <string.h>        
 
 // --- Static variables for this state ---
 static CP_Font tutorial_font;
+static AssetId tutorial_font_id = ASSET_NONE;
 static int tutorialPage;
 
 // --- Button Definitions ---
@@ -163,8 +166,10 @@ static void DrawTutorialBuffExample(float x, float y, float w, float h, const ch
 // Initializes the tutorial pages and font assets.
 void Tutorial_Init(void)
 {
+    Trace_AsyncBegin(TRACE_CAT_STATE, "Tutorial", TRACE_ID_SCREEN);
     // Load the font for this state
-    tutorial_font = CP_Font_Load("Assets/Exo2-Regular.ttf");
+    tutorial_font_id = Asset_Acquire(ASSET_FONT, "Assets/Exo2-Regular.ttf");
+    tutorial_font = Asset_Font(tutorial_font_id);
     CP_Font_Set(tutorial_font);
 
     tutorialPage = 1; // Always start on page 1
@@ -304,7 +309,8 @@ void Tutorial_Update(void)
             "2. Press (S) to use the selected card (Heal/Shield on you, Attack on enemy).\n"
             "3. (Alternative) Click the player to use Heal/Shield or click an enemy to use Attack.\n"
             "4. Press (ENTER) or click 'End Turn' when you are finished.\n"
-            "5. If you play your last card, your turn will end automatically.";
+            "5. If you play your last card, your turn will end automatically.\n"
+            "6. Stuck? Press (H) for a hint: it selects the best card and target.";
 
         CP_Font_DrawTextBox(page1_text, text_start_x, text_start_y, text_box_width);
 
@@ -497,12 +503,10 @@ void Tutorial_Update(void)
     }
 }
 
-// Frees the font resource for the tutorial state.
+// Releases the font resource for the tutorial state.
 void Tutorial_Exit(void)
 {
-    // --- Fixes the memory leak ---
-    if (tutorial_font)
-    {
-        CP_Font_Free(tutorial_font);
-    }
+    Asset_Release(&tutorial_font_id);
+    tutorial_font = NULL;
+    Trace_AsyncEnd(TRACE_CAT_STATE, "Tutorial", TRACE_ID_SCREEN);
 }
\ No newline at end of file
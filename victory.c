@@ -2,15 +2,20 @@
 #include "credit.h"
 #include "game.h"     // To get the death count
 #include "utils.h"    // For IsAreaClicked
+#include "assets.h"
+#include "trace.h"
 #include <stdio.h>
 
 static CP_Font victory_font;
+static AssetId victory_font_id = ASSET_NONE;
 static float vo_timer = 0.0f; // Timer to prevent accidental clicks
 
 // Loads the victory font and resets the input delay timer.
 void Victory_Init(void) {
+    Trace_AsyncBegin(TRACE_CAT_STATE, "Victory", TRACE_ID_SCREEN);
     vo_timer = 0.0f;
-    victory_font = CP_Font_Load("Assets/Exo2-Regular.ttf");
+    victory_font_id = Asset_Acquire(ASSET_FONT, "Assets/Exo2-Regular.ttf");
+    victory_font = Asset_Font(victory_font_id);
     if (victory_font == 0) {
         printf("ERROR: Victory font failed to load! Check Assets folder.\n");
     }
@@ -91,9 +96,9 @@ void Victory_Update(void) {
     }
 }
 
-// Frees the font used in the victory screen.
+// Releases the font used in the victory screen.
 void Victory_Exit(void) {
-    if (victory_font) {
-        CP_Font_Free(victory_font);
-    }
+    Asset_Release(&victory_font_id);
+    victory_font = NULL;
+    Trace_AsyncEnd(TRACE_CAT_STATE, "Victory", TRACE_ID_SCREEN);
 }
\ No newline at end of file
@@ -0,0 +1,130 @@
+// @file workpool.c
+// @brief Lock-free work stealing over index ranges.
+//
+// Each worker owns a range packed into one 64-bit word (begin in the low half, end in the high half).
+// The owner advances begin; thieves lower end. Both sides update the word with compare-exchange, so
+// a job index is handed out exactly once without any locks.
+
+#include "workpool.h"
+#include "platform.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+typedef struct {
+    PlatformAtomic64 range;
+    char padding[64 - sizeof(PlatformAtomic64)]; // Keep each range on its own cache line
+} WorkRange;
+
+typedef struct {
+    WorkRange ranges[WORKPOOL_MAX_WORKERS];
+    int worker_count;
+    uint32_t chunk;
+    WorkPoolJob job;
+    void* ctx;
+} WorkPool;
+
+typedef struct {
+    WorkPool* pool;
+    int worker;
+} WorkerArgs;
+
+static uint64_t PackRange(uint32_t begin, uint32_t end) {
+    return (uint64_t)begin | ((uint64_t)end << 32);
+}
+
+static uint32_t RangeBegin(uint64_t range) { return (uint32_t)range; }
+static uint32_t RangeEnd(uint64_t range) { return (uint32_t)(range >> 32); }
+
+// Takes up to chunk jobs from the front of the worker's own range. Returns false when it is empty.
+static bool PopOwn(WorkPool* pool, int worker, uint32_t* begin, uint32_t* end) {
+    PlatformAtomic64* slot = &pool->ranges[worker].range;
+    for (;;) {
+        uint64_t range = Platform_AtomicLoad64(slot);
+        uint32_t b = RangeBegin(range);
+        uint32_t e = RangeEnd(range);
+        if (b >= e) return false;
+        uint32_t next = (e - b > pool->chunk) ? b + pool->chunk : e;
+        if (Platform_AtomicCompareExchange64(slot, range, PackRange(next, e))) {
+            *begin = b;
+            *end = next;
+            return true;
+        }
+    }
+}
+
+// Steals the back half of the largest range still held by another worker into the thief's range.
+static bool Steal(WorkPool* pool, int thief) {
+    for (;;) {
+        int victim = -1;
+        uint32_t victim_left = 1;
+        uint64_t victim_range = 0;
+        for (int i = 0; i < pool->worker_count; i++) {
+            if (i == thief) continue;
+            uint64_t range = Platform_AtomicLoad64(&pool->ranges[i].range);
+            uint32_t b = RangeBegin(range);
+            uint32_t e = RangeEnd(range);
+            if (e > b && e - b > victim_left) {
+                victim = i;
+                victim_left = e - b;
+                victim_range = range;
+            }
+        }
+        // Ranges with a single job left are finished by their owner
+        if (victim < 0) return false;
+
+        uint32_t b = RangeBegin(victim_range);
+        uint32_t e = RangeEnd(victim_range);
+        uint32_t mid = b + (e - b) / 2;
+        if (Platform_AtomicCompareExchange64(&pool->ranges[victim].range, victim_range, PackRange(b, mid))) {
+            Platform_AtomicStore64(&pool->ranges[thief].range, PackRange(mid, e));
+            return true;
+        }
+    }
+}
+
+static void WorkerLoop(void* param) {
+    WorkerArgs* args = (WorkerArgs*)param;
+    WorkPool* pool = args->pool;
+    uint32_t begin, end;
+    do {
+        while (PopOwn(pool, args->worker, &begin, &end)) {
+            pool->job(begin, end, args->worker, pool->ctx);
+        }
+    } while (Steal(pool, args->worker));
+}
+
+void WorkPool_Run(uint32_t job_count, int worker_count, uint32_t chunk, WorkPoolJob job, void* ctx) {
+    if (!job || job_count == 0) return;
+    if (worker_count < 1) worker_count = 1;
+    if (worker_count > WORKPOOL_MAX_WORKERS) worker_count = WORKPOOL_MAX_WORKERS;
+    if ((uint32_t)worker_count > job_count) worker_count = (int)job_count;
+    if (chunk == 0) chunk = 1;
+
+    WorkPool pool;
+    pool.worker_count = worker_count;
+    pool.chunk = chunk;
+    pool.job = job;
+    pool.ctx = ctx;
+
+    // Initial even split
+    for (int i = 0; i < worker_count; i++) {
+        uint32_t b = (uint32_t)(((uint64_t)job_count * (uint64_t)i) / (uint64_t)worker_count);
+        uint32_t e = (uint32_t)(((uint64_t)job_count * (uint64_t)(i + 1)) / (uint64_t)worker_count);
+        Platform_AtomicStore64(&pool.ranges[i].range, PackRange(b, e));
+    }
+
+    WorkerArgs args[WORKPOOL_MAX_WORKERS];
+    PlatformThread* threads[WORKPOOL_MAX_WORKERS] = { NULL };
+    for (int i = 0; i < worker_count; i++) {
+        args[i].pool = &pool;
+        args[i].worker = i;
+    }
+    for (int i = 1; i < worker_count; i++) {
+        threads[i] = Platform_ThreadStart(WorkerLoop, &args[i]);
+    }
+    WorkerLoop(&args[0]);
+    for (int i = 1; i < worker_count; i++) {
+        if (threads[i]) Platform_ThreadJoin(threads[i]);
+        else WorkerLoop(&args[i]); // Thread never started: drain its range here
+    }
+}
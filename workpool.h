@@ -0,0 +1,13 @@
+// Work-stealing parallel-for used by the simulator to spread runs over every core.
+#pragma once
+#include <stdint.h>
+
+#define WORKPOOL_MAX_WORKERS 64
+
+// Processes jobs [begin, end) on the given worker (0 .. worker_count - 1).
+typedef void (*WorkPoolJob)(uint32_t begin, uint32_t end, int worker, void* ctx);
+
+// Splits [0, job_count) evenly across worker_count threads (the caller's thread is worker 0).
+// Each worker takes chunk-sized slices from the front of its own range; an idle worker steals the
+// back half of the busiest remaining range. Returns once every job has been processed.
+void WorkPool_Run(uint32_t job_count, int worker_count, uint32_t chunk, WorkPoolJob job, void* ctx);
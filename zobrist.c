@@ -0,0 +1,41 @@
+// @file zobrist.c
+// @brief Full-state Zobrist hashes; the O(1) per-field updates are inline in zobrist.h.
+
+#include "zobrist.h"
+#include <stddef.h>
+
+int Zobrist_PlayerBuffBits(const Player* player) {
+    return (player->has_lifesteal ? 1 : 0)
+        | (player->has_divine_strike ? 2 : 0)
+        | (player->has_shield_boost ? 4 : 0)
+        | (player->has_attack_boost_35 ? 8 : 0)
+        | (player->has_heal_boost_35 ? 16 : 0)
+        | (player->has_shield_boost_35 ? 32 : 0);
+}
+
+uint64_t Zobrist_HashPlayer(const Player* player) {
+    if (!player) return 0;
+    return Zobrist_Key(ZOBRIST_PLAYER_HEALTH, 0, player->health)
+        ^ Zobrist_Key(ZOBRIST_PLAYER_SHIELD, 0, player->shield)
+        ^ Zobrist_Key(ZOBRIST_PLAYER_MAX_HEALTH, 0, player->max_health)
+        ^ Zobrist_Key(ZOBRIST_PLAYER_ATTACK_BONUS, 0, player->attack_bonus)
+        ^ Zobrist_Key(ZOBRIST_PLAYER_HEAL_BONUS, 0, player->heal_bonus)
+        ^ Zobrist_Key(ZOBRIST_PLAYER_SHIELD_BONUS, 0, player->shield_bonus)
+        ^ Zobrist_Key(ZOBRIST_PLAYER_BUFFS, 0, Zobrist_PlayerBuffBits(player));
+}
+
+uint64_t Zobrist_HashEnemy(const Encounter* encounter, int slot) {
+    if (!encounter) return 0;
+    return Zobrist_Key(ZOBRIST_ENEMY_HEALTH, slot, encounter->health[slot])
+        ^ Zobrist_Key(ZOBRIST_ENEMY_SHIELD, slot, encounter->shield[slot])
+        ^ Zobrist_Key(ZOBRIST_ENEMY_ATTACK, slot, encounter->attack[slot])
+        ^ Zobrist_Key(ZOBRIST_ENEMY_ALIVE, slot, encounter->alive[slot] ? 1 : 0);
+}
+
+uint64_t Zobrist_HashCombat(const Player* player, const Encounter* encounter) {
+    uint64_t hash = Zobrist_HashPlayer(player);
+    for (int i = 0; encounter && i < encounter->enemy_count; i++) {
+        hash ^= Zobrist_HashEnemy(encounter, i);
+    }
+    return hash;
+}
@@ -0,0 +1,57 @@
+// Zobrist hashing of combat state. Every hashed field contributes Zobrist_Key(feature, slot, value),
+// XORed together, so changing one field is an O(1) update: XOR out the old key, XOR in the new one.
+// The hand is a multiset, so card keys are added instead (duplicate cards would cancel under XOR).
+#pragma once
+#include <stdint.h>
+#include "player.h"
+#include "levels.h"
+#include "carddef.h"
+
+typedef enum {
+    ZOBRIST_PLAYER_HEALTH,
+    ZOBRIST_PLAYER_SHIELD,
+    ZOBRIST_PLAYER_MAX_HEALTH,
+    ZOBRIST_PLAYER_ATTACK_BONUS,
+    ZOBRIST_PLAYER_HEAL_BONUS,
+    ZOBRIST_PLAYER_SHIELD_BONUS,
+    ZOBRIST_PLAYER_BUFFS,     // Bit set of the combat buffs, see Zobrist_PlayerBuffBits
+    ZOBRIST_ENEMY_HEALTH,     // Slot is the enemy index
+    ZOBRIST_ENEMY_SHIELD,
+    ZOBRIST_ENEMY_ATTACK,
+    ZOBRIST_ENEMY_ALIVE,
+    ZOBRIST_PLAYED_CARDS,
+    ZOBRIST_CARD              // Slot packs type and effect; value is the power
+} ZobristFeature;
+
+// Returns the random key for a feature in a slot holding a value. Keys come from a fixed
+// SplitMix64 stream, so hashes are stable across runs and threads.
+static inline uint64_t Zobrist_Key(ZobristFeature feature, int slot, int value) {
+    uint64_t z = ((uint64_t)feature << 56) ^ ((uint64_t)(uint32_t)slot << 32) ^ (uint64_t)(uint32_t)value;
+    z += 0x9E3779B97F4A7C15ull;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+// Moves a field's contribution from old_value to new_value.
+static inline void Zobrist_Update(uint64_t* hash, ZobristFeature feature, int slot, int old_value, int new_value) {
+    if (old_value == new_value) return;
+    *hash ^= Zobrist_Key(feature, slot, old_value) ^ Zobrist_Key(feature, slot, new_value);
+}
+
+// Key of a card for the additive hand hash.
+static inline uint64_t Zobrist_CardKey(CardType type, CardEffect effect, int power) {
+    return Zobrist_Key(ZOBRIST_CARD, ((int)type << 8) | (int)effect, power);
+}
+
+// Packs the buffs the combat rules read into one value.
+int Zobrist_PlayerBuffBits(const Player* player);
+
+// Full hash of a player (health, shield, bonuses and combat buffs).
+uint64_t Zobrist_HashPlayer(const Player* player);
+
+// Full hash of the enemy at index slot of an encounter.
+uint64_t Zobrist_HashEnemy(const Encounter* encounter, int slot);
+
+// Full hash of a player and an encounter (which may be NULL). Incremental updates must always match this.
+uint64_t Zobrist_HashCombat(const Player* player, const Encounter* encounter);